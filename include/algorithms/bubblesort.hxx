@@ -3,29 +3,26 @@
 
 #include <SFML/Graphics.hpp>
 
-#include <sv/elements.hxx>
-#include <sv/viewer.hxx>
+#include <sv/access.hxx>
 
 #include <functional>
 #include <ranges>
 
 namespace sv::algorithms
 {
-    auto bubblesort(
-        std::shared_ptr<Elements> elems,
-        std::shared_ptr<Viewer> viewer
-    ) noexcept -> void
+    template<access_policy A>
+    auto bubblesort(A& access) -> void
     {
-        auto N { elems->size() };
+        auto N { access.size() };
         
         for (auto i { 0uL }; i != (N - 1uL); ++i)
             for (auto j { 0uL }; j < (N - i - 1uL); ++j)
             {
-                viewer->mark(j, sf::Color::Red);
-                if (elems->compare(j, j + 1uL, std::ranges::greater{}))
-                    elems->swap_elems(j, j + 1uL);
+                access.mark(j, sf::Color::Red);
+                if (access.compare(j, j + 1uL, std::ranges::greater{}))
+                    access.swap_elems(j, j + 1uL);
 
-                viewer->unmark(j);
+                access.unmark(j);
             }
     }
 
@@ -3,12 +3,13 @@
 
 #include <SFML/Graphics.hpp>
 
-#include <sv/elements.hxx>
-#include <sv/viewer.hxx>
+#include <sv/access.hxx>
+#include <sv/keys.hxx>
 
 #include <algorithm>
+#include <array>
 #include <functional>
-#include <list>
+#include <numeric>
 #include <ranges>
 #include <vector>
 
@@ -16,99 +17,108 @@ namespace sv::algorithms
 {
     namespace
     {
+        template<access_policy A>
         auto bucketsort_min(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             std::size_t first,
             std::size_t last
-        ) noexcept -> sv::Elements::element_type
+        ) -> typename A::element_type
         {
             auto minidx { first };
 
             for (auto i { 0uL }; i < last; ++i)
             {
-                viewer->mark(i, sf::Color::Yellow);
+                access.mark(i, sf::Color::Yellow);
 
-                if (elems->compare(i, minidx))
+                if (access.compare(i, minidx))
                     minidx = i;
 
-                viewer->unmark(i);
+                access.unmark(i);
             }
 
-            return elems->read(minidx);
+            return access.read(minidx);
         }
         
+        template<access_policy A>
         auto bucketsort_max(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             std::size_t first,
             std::size_t last
-        ) noexcept -> sv::Elements::element_type
+        ) -> typename A::element_type
         {
             auto maxidx { first };
 
             for (auto i { 0uL }; i < last; ++i)
             {
-                viewer->mark(i, sf::Color::Cyan);
+                access.mark(i, sf::Color::Cyan);
 
-                if (elems->compare(i, maxidx, std::ranges::greater{}))
+                if (access.compare(i, maxidx, std::ranges::greater{}))
                     maxidx = i;
 
-                viewer->unmark(i);
+                access.unmark(i);
             }
 
-            return elems->read(maxidx);
+            return access.read(maxidx);
         }
     }
 
-    auto bucketsort(
-        std::shared_ptr<Elements> elems,
-        std::shared_ptr<Viewer> viewer
-    ) noexcept -> void
+    template<access_policy A>
+    auto bucketsort(A& access) -> void
     {
-        using element_type = Elements::element_type;
+        using element_type = typename A::element_type;
 
-        auto N { elems->size() };
+        auto N { access.size() };
         auto bucket_size { 10uL };
-        auto&& [cp, rd, wr, sw] = elems->counters();
 
-        auto min { bucketsort_min(elems, viewer, 0uL, N) };
-        auto max { bucketsort_max(elems, viewer, 0uL, N) };
-        auto range { (max - min) / static_cast<element_type>(bucket_size) };
+        auto min { bucketsort_min(access, 0uL, N) };
+        auto max { bucketsort_max(access, 0uL, N) };
+        auto range { key_distance(max, min) / static_cast<double>(bucket_size) };
 
-        auto buckets = std::vector(bucket_size, std::vector<element_type>{});
+        auto bucket = [&](element_type v)
+        {
+            if (!(range > 0.0))
+                return 0uL;
+
+            return std::min(static_cast<std::size_t>(key_distance(v, min) / range), bucket_size - 1uL);
+        };
 
-        for (auto i { 0uL }; i < elems->size(); ++i)
+        /// Buckets are laid out back to back in one lease: a counting pass
+        /// sizes them, a second pass scatters into place.
+        auto offsets = std::array<std::size_t, 11uL>{};
+
+        for (auto i { 0uL }; i < N; ++i)
         {
-            viewer->mark(i, sf::Color::Red);
-            auto diff { ((elems->read(i) - min) / range) - static_cast<std::size_t>((elems->read(i) - min) / range )};
+            access.mark(i, sf::Color::Red);
+            offsets.at(bucket(access.read(i)) + 1uL) += 1uL;
+            access.count_comparisons();
+            access.unmark(i);
+        }
 
-            if (diff == 0 && elems->read(i) != min)
-            {
-                buckets.at(static_cast<std::size_t>((elems->read(i) - min) / range) - 1uL).push_back(elems->read(i));
-            }
-            else
-            {
-                buckets.at(static_cast<std::size_t>((elems->read(i) - min) / range)).push_back(elems->read(i));
-            }
-            cp += 1uL;
-            viewer->unmark(i);
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        auto flat   = access.lease(N);
+        auto cursor { offsets };
+
+        for (auto i { 0uL }; i < N; ++i)
+        {
+            access.mark(i, sf::Color::Red);
+            auto v { access.read(i) };
+            flat.write(cursor.at(bucket(v))++, v);
+            access.unmark(i);
+        }
+
+        for (auto b { 0uL }; b < bucket_size; ++b)
+        {
+            std::ranges::sort(flat.data() + offsets.at(b), flat.data() + offsets.at(b + 1uL));
+            flat.mark_range(offsets.at(b), offsets.at(b + 1uL), b % 2uL ? sf::Color::Cyan : sf::Color::Magenta);
         }
 
-        for (auto& bckt : buckets)
-            if (!bckt.empty())
-                std::ranges::sort(bckt);
-
-        auto k { 0uL };
-        for (auto& bckt : buckets)
-            if (!bckt.empty())
-                for (auto& e : bckt)
-                {
-                    viewer->mark(k, sf::Color::Blue);
-                    elems->write(k, e);
-                    viewer->unmark(k);
-                    k += 1uL;
-                }
+        for (auto k { 0uL }; k < N; ++k)
+        {
+            access.mark(k, sf::Color::Blue);
+            access.write(k, flat.read(k));
+            access.unmark(k);
+        }
     }
 
 }  /// namespace sv::algorithms
@@ -3,10 +3,14 @@
 
 #include <SFML/Graphics.hpp>
 
-#include <sv/elements.hxx>
-#include <sv/viewer.hxx>
+#include <algorithms/radixsort.hxx>
 
+#include <sv/access.hxx>
+#include <sv/keys.hxx>
+
+#include <concepts>
 #include <functional>
+#include <iostream>
 #include <ranges>
 #include <vector>
 
@@ -14,89 +18,139 @@ namespace sv::algorithms
 {
     namespace
     {
+        /// Largest count table, in slots, counting sort will lease.
+        constexpr auto counting_limit { 1uL << 24uL };
+
+        template<access_policy A>
         auto countingsort_min(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             std::size_t first,
             std::size_t last
-        ) noexcept -> sv::Elements::element_type
+        ) -> typename A::element_type
         {
             auto minidx { first };
 
             for (auto i { 0uL }; i < last; ++i)
             {
-                viewer->mark(i, sf::Color::Yellow);
+                access.mark(i, sf::Color::Yellow);
 
-                if (elems->compare(i, minidx))
+                if (access.compare(i, minidx))
                     minidx = i;
 
-                viewer->unmark(i);
+                access.unmark(i);
             }
 
-            return elems->read(minidx);
+            return access.read(minidx);
         }
         
+        template<access_policy A>
         auto countingsort_max(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             std::size_t first,
             std::size_t last
-        ) noexcept -> sv::Elements::element_type
+        ) -> typename A::element_type
         {
             auto maxidx { first };
 
             for (auto i { 0uL }; i < last; ++i)
             {
-                viewer->mark(i, sf::Color::Cyan);
+                access.mark(i, sf::Color::Cyan);
 
-                if (elems->compare(i, maxidx, std::ranges::greater{}))
+                if (access.compare(i, maxidx, std::ranges::greater{}))
                     maxidx = i;
 
-                viewer->unmark(i);
+                access.unmark(i);
             }
 
-            return elems->read(maxidx);
+            return access.read(maxidx);
         }
-    }
 
-    auto countingsort(
-        std::shared_ptr<Elements> elems,
-        std::shared_ptr<Viewer> viewer
-    ) noexcept -> void
-    {
-        using sort_type     = unsigned int;
-        using element_type  = Elements::element_type;
+        /// Counts every key's distance from `min` and places the elements
+        /// by it. Gives up before moving anything if a key turns out not
+        /// to be a whole number, which a count table can't order.
+        template<access_policy A>
+        auto countingsort_count(
+            A& access,
+            typename A::element_type min,
+            typename A::element_type max
+        ) -> bool
+        {
+            using element_type  = typename A::element_type;
 
-        auto N { static_cast<long long>(elems->size()) };
-        
-        auto min { static_cast<sort_type>(countingsort_min(elems, viewer, 0LL, N)) };
-        auto max { static_cast<sort_type>(countingsort_max(elems, viewer, 0LL, N)) };
-        auto range { max - min + 1uL };
+            auto N { static_cast<long long>(access.size()) };
 
-        auto count  = std::vector(range, std::size_t{});
-        auto output = std::vector(N, element_type{});
+            /// Integers are counted by their exact distance, which the
+            /// doubles in `key_distance` lose past 2^53.
+            auto slot = [&](element_type value) -> std::size_t
+            {
+                if constexpr (std::integral<key_type_t<element_type>>)
+                    return static_cast<std::size_t>(radix_bits(value) - radix_bits(min));
+                else
+                    return static_cast<std::size_t>(key_distance(value, min));
+            };
 
-        for (auto i { 0LL }; i < N; ++i)
-        {
-            viewer->mark(i, sf::Color::Red);
-            count.at(static_cast<sort_type>(elems->read(i)) - min) += 1uL;
-            viewer->unmark(i);
+            auto count  = lease_table<std::size_t>(access, slot(max) + 1uL);
+            auto output = access.lease(static_cast<std::size_t>(N));
+
+            for (auto i { 0LL }; i < N; ++i)
+            {
+                access.mark(i, sf::Color::Red);
+                auto value { access.read(i) };
+                access.unmark(i);
+
+                if (!whole_key(value))
+                    return false;
+
+                count[slot(value)] += 1uL;
+            }
+
+            for (auto i { 1uL }; i < count.size(); ++i)
+                count[i] += count[i - 1uL];
+
+            for (auto i { N - 1LL }; i >= 0LL; --i)
+            {
+                auto value { access.read(i) };
+                count[slot(value)] -= 1uL;
+                output.write(count[slot(value)], value);
+            }
+
+            for (auto i { 0LL }; i < N; ++i)
+            {
+                access.mark(i, sf::Color::Blue);
+                access.write(i, output.read(i));
+                access.unmark(i);
+            }
+
+            return true;
         }
+    }
+
+    /// Counts whole-number keys by their distance from the minimum. Key
+    /// ranges too wide for a count table, and keys with a fractional
+    /// part, are handed to the radix sort.
+    template<access_policy A>
+    auto countingsort(A& access) -> void
+    {
+        auto N { static_cast<long long>(access.size()) };
+
+        if (N < 2LL)
+            return;
 
-        for (auto i { 1LL }; i < static_cast<long long>(count.size()); ++i)
-            count.at(i) += count.at(i - 1uL);
+        auto min { countingsort_min(access, 0LL, N) };
+        auto max { countingsort_max(access, 0LL, N) };
+        auto distance { key_distance(max, min) };
 
-        for (auto i { N - 1LL }; i >= 0LL; --i)
+        if (!(distance < static_cast<double>(counting_limit)))
         {
-            output.at(count.at(static_cast<sort_type>(elems->read(i)) - min) - 1uL) = elems->read(i);
-            count.at(static_cast<sort_type>(elems->read(i)) - min) -= 1uL;
+            std::clog << "Key range of " << distance << " is too wide to count, using radix sort." << std::endl;
+            radixsort(access);
+            return;
         }
 
-        for (auto i { 0LL }; i < N; ++i)
+        if (!countingsort_count(access, min, max))
         {
-            viewer->mark(i, sf::Color::Blue);
-            elems->write(i, output.at(i));
-            viewer->unmark(i);
+            std::clog << "Keys with a fractional part can't be counted, using radix sort." << std::endl;
+            radixsort(access);
         }
     }
 
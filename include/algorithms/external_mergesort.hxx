@@ -0,0 +1,140 @@
+#ifndef SV_ALGORITHMS_EXTERNAL_MERGE_SORT
+#   define SV_ALGORITHMS_EXTERNAL_MERGE_SORT
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithms/vectorized_introsort.hxx>
+
+#include <sv/access.hxx>
+#include <sv/loser_tree.hxx>
+
+#include <algorithm>
+#include <span>
+
+namespace sv::algorithms
+{
+    namespace
+    {
+        /// Runs the array is cut into, standing in for the file size over
+        /// the memory budget.
+        constexpr auto external_runs { 8uL };
+
+        /// Blocks per run the merge streams each run in.
+        constexpr auto external_blocks { 8uL };
+
+        /// Reads the next block of run `r` into its merge buffer. Returns
+        /// how many elements it holds.
+        template<access_policy A>
+        auto external_refill(
+            A& access,
+            typename A::element_type* buffer,
+            std::size_t& head,
+            std::size_t end,
+            std::size_t block
+        ) -> std::size_t
+        {
+            auto n { std::min(block, end - head) };
+
+            access.read_block(head, std::span{ buffer, n });
+            head += n;
+
+            return n;
+        }
+    }
+
+    /// Models the out-of-core mergesort `sv-extsort` runs over files on
+    /// the array. Budget-sized runs are read as one block, sorted in
+    /// memory and written back; a loser tree then merges them through one
+    /// buffered block per run into an output the size of the array. Runs
+    /// stay coloured as segments and the frontier of each is green.
+    template<access_policy A>
+    auto external_mergesort(A& access) -> void
+    {
+        using element_type = typename A::element_type;
+
+        auto N { access.size() };
+
+        if (N < 2uL)
+            return;
+
+        auto length { (N + external_runs - 1uL) / external_runs };
+        auto k      { (N + length - 1uL) / length };
+        auto block  { std::max(length / external_blocks, 1uL) };
+
+        {
+            auto memory = access.lease(length);
+
+            for (auto r { 0uL }; r < k; ++r)
+            {
+                auto first { r * length };
+                auto last  { std::min(first + length, N) };
+                auto run   = std::span{ memory.data(), last - first };
+
+                access.mark_range(first, last, sf::Color::Red);
+                access.read_block(first, run);
+
+                auto native = NativeAccess<element_type>{ run, access.scratch() };
+                vectorized_introsort(native);
+
+                access.write_block(first, run);
+                access.mark_range(first, last, r % 2uL ? sf::Color::Cyan : sf::Color::Magenta);
+            }
+        }
+
+        auto buffers = access.lease(k * block);
+        auto output  = access.lease(N);
+        auto heads   = lease_table<std::size_t>(access, k);
+        auto cursors = lease_table<std::size_t>(access, k);
+        auto fills   = lease_table<std::size_t>(access, k);
+        auto tree    = LoserTree<element_type>{ k };
+
+        for (auto r { 0uL }; r < k; ++r)
+        {
+            heads[r] = r * length;
+            fills[r] = external_refill(access, buffers.data() + r * block, heads[r], std::min(heads[r] + length, N), block);
+            tree.set(r, buffers.data()[r * block]);
+            access.mark(r * length, sf::Color::Green);
+        }
+
+        tree.build();
+
+        for (auto i { 0uL }; i < N; ++i)
+        {
+            auto r { tree.winner() };
+            auto frontier { heads[r] - fills[r] + cursors[r] };
+
+            output.write(i, tree.top());
+            access.count_comparisons(tree.levels());
+            access.unmark(frontier);
+
+            if (++cursors[r] == fills[r])
+            {
+                auto end { std::min((r + 1uL) * length, N) };
+
+                if (heads[r] == end)
+                {
+                    tree.exhaust();
+                    continue;
+                }
+
+                fills[r]   = external_refill(access, buffers.data() + r * block, heads[r], end, block);
+                cursors[r] = 0uL;
+            }
+
+            access.mark(frontier + 1uL, sf::Color::Green);
+            tree.replace(buffers.data()[r * block + cursors[r]]);
+        }
+
+        for (auto first { 0uL }; first < N; first += block)
+        {
+            auto n { std::min(block, N - first) };
+
+            access.mark_range(first, first + n, sf::Color::Blue);
+            access.write_block(first, std::span{ output.data() + first, n });
+            access.unmark_range(first, first + n);
+        }
+    }
+
+}  /// namespace sv::algorithms
+
+#endif  // SV_ALGORITHMS_EXTERNAL_MERGE_SORT
@@ -3,8 +3,8 @@
 
 #include <SFML/Graphics.hpp>
 
-#include <sv/elements.hxx>
-#include <sv/viewer.hxx>
+#include <sv/access.hxx>
+#include <sv/perf.hxx>
 
 #include <cmath>
 #include <functional>
@@ -15,40 +15,38 @@ namespace sv::algorithms
 {
     namespace
     {
+        template<access_policy A>
         auto make_heap(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             std::size_t N,
             std::size_t i
-        ) noexcept -> void
+        ) -> void
         {
             auto max   { i };
             auto left  { 2uL * i + 1uL };
             auto right { 2uL * i + 2uL };
 
-            if (left < N && elems->compare(left, max, std::ranges::greater{}))
+            if (left < N && access.compare(left, max, std::ranges::greater{}))
                 max = left;
 
-            if (right < N && elems->compare(right, max, std::ranges::greater{}))
+            if (right < N && access.compare(right, max, std::ranges::greater{}))
                 max = right;
 
             if (max != i)
             {
-                elems->swap_elems(i, max);
-                make_heap(elems, viewer, N, max);
+                access.swap_elems(i, max);
+                make_heap(access, N, max);
             }
         }
     }
 
-    auto heapsort(
-        std::shared_ptr<Elements> elems,
-        std::shared_ptr<Viewer> viewer
-    ) noexcept -> void
+    template<access_policy A>
+    auto heapsort(A& access) -> void
     {
         auto rd   = std::random_device{};
         auto reng = std::mt19937{ rd() };
 
-        auto N { static_cast<long>(elems->size()) };
+        auto N { static_cast<long>(access.size()) };
         auto levels { static_cast<long>(std::floor(std::log2(N))) + 1L };
 
         auto last_level { 0L };
@@ -60,21 +58,25 @@ namespace sv::algorithms
             auto g { static_cast<unsigned char>(reng() % 255) };
             auto b { static_cast<unsigned char>(reng() % 255) };
 
-            viewer->mark_range(last_level, lsize, sf::Color(r, g, b));
+            access.mark_range(last_level, lsize, sf::Color(r, g, b));
             last_level = lsize;
         }
-        
-        for (auto i { (N / 2L) - 1L }; i >= 0L; --i)
-            make_heap(elems, viewer, N, i);
+
+        {
+            auto phase = PhaseScope{ PerfPhase::HEAPIFY };
+
+            for (auto i { (N / 2L) - 1L }; i >= 0L; --i)
+                make_heap(access, N, i);
+        }
 
         for (auto i { N - 1L}; i >= 0L; --i)
         {
-            viewer->mark(0uL, sf::Color::Magenta);
-            viewer->mark(i, sf::Color::Magenta);
-            elems->swap_elems(0uL, i);
-            make_heap(elems, viewer, i, 0uL);
-            viewer->unmark(0uL);
-            viewer->unmark(i);
+            access.mark(0uL, sf::Color::Magenta);
+            access.mark(i, sf::Color::Magenta);
+            access.swap_elems(0uL, i);
+            make_heap(access, i, 0uL);
+            access.unmark(0uL);
+            access.unmark(i);
         }
     }
 
@@ -3,39 +3,37 @@
 
 #include <SFML/Graphics.hpp>
 
-#include <sv/elements.hxx>
-#include <sv/viewer.hxx>
+#include <sv/access.hxx>
+#include <sv/perf.hxx>
 
 #include <functional>
 #include <ranges>
 
 namespace sv::algorithms
 {
-    auto insertionsort(
-        std::shared_ptr<Elements> elems,
-        std::shared_ptr<Viewer> viewer
-    ) noexcept -> void
+    template<access_policy A>
+    auto insertionsort(A& access) -> void
     {
-        for (auto i { 1LL }; i < static_cast<long long>(elems->size()); ++i)
+        auto phase = PhaseScope{ PerfPhase::INSERTION };
+
+        for (auto i { 1LL }; i < static_cast<long long>(access.size()); ++i)
         {
-            viewer->mark(i, sf::Color::Red);
-            auto current { elems->read(i) };
+            access.mark(i, sf::Color::Red);
+            auto current { access.read(i) };
             auto j { i - 1LL };
 
-            auto&& [cmp, r, w, s] = elems->counters();
-
-            while (j >= 0LL && elems->read(j) > current)
+            while (j >= 0LL && access.read(j) > current)
             {
-                viewer->mark(j + 1LL, sf::Color::Blue);
-                elems->write(j + 1LL, elems->read(j));
-                viewer->unmark(j + 1LL);
+                access.mark(j + 1LL, sf::Color::Blue);
+                access.write(j + 1LL, access.read(j));
+                access.unmark(j + 1LL);
                 j -= 1LL;
-                cmp += 1uL;
+                access.count_comparisons();
             }
 
-            cmp += 1uL;
-            elems->write(j + 1LL, current);
-            viewer->unmark(i);
+            access.count_comparisons();
+            access.write(j + 1LL, current);
+            access.unmark(i);
         }
     }
 
@@ -7,8 +7,8 @@
 #include <algorithms/insertionsort.hxx>
 #include <algorithms/quicksort.hxx>
 
-#include <sv/elements.hxx>
-#include <sv/viewer.hxx>
+#include <sv/access.hxx>
+#include <sv/perf.hxx>
 
 #include <algorithm>
 #include <cmath>
@@ -20,66 +20,64 @@ namespace sv::algorithms
 {
     namespace
     {
+        template<access_policy A>
         auto introsort_insertion(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             long long low,
             long long high
-        ) noexcept -> void
+        ) -> void
         {
             for (auto i { low + 1LL }; i <= high; ++i)
             {
-                viewer->mark(i, sf::Color::Yellow);
-                auto current { elems->read(i) };
+                access.mark(i, sf::Color::Yellow);
+                auto current { access.read(i) };
                 auto j { static_cast<long long>(i) - 1LL };
 
-                auto&& [cmp, r, w, s] = elems->counters();
-
-                while (j >= low && elems->read(j) > current)
+                while (j >= low && access.read(j) > current)
                 {
-                    viewer->mark(j + 1LL, sf::Color::Cyan);
-                    elems->write(j + 1LL, elems->read(j));
-                    viewer->unmark(j + 1LL);
+                    access.mark(j + 1LL, sf::Color::Cyan);
+                    access.write(j + 1LL, access.read(j));
+                    access.unmark(j + 1LL);
                     j -= 1LL;
-                    cmp += 1uL;
+                    access.count_comparisons();
                 }
 
-                cmp += 1uL;
-                elems->write(j + 1LL, current);
-                viewer->unmark(i);
+                access.count_comparisons();
+                access.write(j + 1LL, current);
+                access.unmark(i);
             }
         }
 
+        template<access_policy A>
         auto introsort_make_heap(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             std::size_t N,
             std::size_t i
-        ) noexcept -> void
+        ) -> void
         {
             auto max   { i };
             auto left  { 2uL * i + 1uL };
             auto right { 2uL * i + 2uL };
 
-            if (left < N && elems->compare(left, max, std::ranges::greater{}))
+            if (left < N && access.compare(left, max, std::ranges::greater{}))
                 max = left;
 
-            if (right < N && elems->compare(right, max, std::ranges::greater{}))
+            if (right < N && access.compare(right, max, std::ranges::greater{}))
                 max = right;
 
             if (max != i)
             {
-                elems->swap_elems(i, max);
-                make_heap(elems, viewer, N, max);
+                access.swap_elems(i, max);
+                make_heap(access, N, max);
             }
         }
 
+        template<access_policy A>
         auto introsort_heapsort(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             long long low,
             long long high
-        ) noexcept -> void
+        ) -> void
         {
             auto rd   = std::random_device{};
             auto reng = std::mt19937{ rd() };
@@ -96,127 +94,133 @@ namespace sv::algorithms
                 auto g { static_cast<unsigned char>(reng() % 255) };
                 auto b { static_cast<unsigned char>(reng() % 255) };
 
-                viewer->mark_range(last_level, lsize, sf::Color(r, g, b));
+                access.mark_range(last_level, lsize, sf::Color(r, g, b));
                 last_level = lsize;
             }
-            
-            for (auto i { (N / 2L) - 1L }; i >= low; --i)
-                introsort_make_heap(elems, viewer, N, i);
+
+            {
+                auto phase = PhaseScope{ PerfPhase::HEAPIFY };
+
+                for (auto i { (N / 2L) - 1L }; i >= low; --i)
+                    introsort_make_heap(access, N, i);
+            }
 
             for (auto i { N - 1L }; i >= low; --i)
             {
-                viewer->mark(low, sf::Color::Magenta);
-                viewer->mark(i, sf::Color::Magenta);
-                elems->swap_elems(low, i);
-                introsort_make_heap(elems, viewer, i, low);
-                viewer->unmark(low);
-                viewer->unmark(i);
+                access.mark(low, sf::Color::Magenta);
+                access.mark(i, sf::Color::Magenta);
+                access.swap_elems(low, i);
+                introsort_make_heap(access, i, low);
+                access.unmark(low);
+                access.unmark(i);
             }
 
-            viewer->unmark_range(low, last_level);
+            access.unmark_range(low, last_level);
         }
 
+        template<access_policy A>
         auto median_three(
-            std::shared_ptr<Elements> elems,
-            [[maybe_unused]] std::shared_ptr<Viewer> viewer,
+            A& access,
             long long a,
             long long b,
             long long c            
-        ) noexcept -> long long
+        ) -> long long
         { 
             auto r = std::max(
                 std::min(
-                    elems->read(a),
-                    elems->read(b)
+                    access.read(a),
+                    access.read(b)
                 ), 
                 std::min(
                     std::max(
-                        elems->read(a),
-                        elems->read(b)
+                        access.read(a),
+                        access.read(b)
                     ),
-                    elems->read(c)
+                    access.read(c)
                 )
             );
 
-            auto&& [cp, rd, wr, sw] = elems->counters();
-            cp += 4uL;
+            access.count_comparisons(4uL);
 
-            return elems->silent_read(a) == r ? a 
-                 : elems->silent_read(b) == r ? b : c;
+            return access.silent_read(a) == r ? a 
+                 : access.silent_read(b) == r ? b : c;
         }
         
+        template<access_policy A>
         auto introsort_partition(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             long long low,
             long long high
-        ) noexcept -> long long
+        ) -> long long
         {
-            auto N { static_cast<long long>(elems->size()) - 1LL };
+            auto N { static_cast<long long>(access.size()) - 1LL };
             auto i { low - 1LL };
             
             for (auto j { low }; j <= high - 1LL; ++j)
             {
-                viewer->mark_range(std::ranges::clamp(i, 0LL, N), j - 1LL, sf::Color::Blue);
-                viewer->mark(j - 1LL, sf::Color::Red);
+                access.mark_range(std::ranges::clamp(i, 0LL, N), j - 1LL, sf::Color::Blue);
+                access.mark(j - 1LL, sf::Color::Red);
 
-                if (elems->compare(j, high, std::ranges::less_equal{}))
+                if (access.compare(j, high, std::ranges::less_equal{}))
                 {
                     i += 1LL;
                     
                     if (i != j)
-                        elems->swap_elems(i, j);
+                        access.swap_elems(i, j);
                 }
 
-                viewer->unmark_range(std::ranges::clamp(i - 1LL, 0LL, N), j);
+                access.unmark_range(std::ranges::clamp(i - 1LL, 0LL, N), j);
             }
 
-            elems->swap_elems(i + 1LL, high);
+            access.swap_elems(i + 1LL, high);
             return i + 1LL;
         }
 
+        template<access_policy A>
         auto introsort_impl(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             std::size_t low,
             std::size_t high,
             std::size_t maxdepth
-        ) noexcept -> void
+        ) -> void
         {
             auto N { high - low };
 
             if (N > 1uL)
             {
                 if (maxdepth == 0uL)
-                    introsort_heapsort(elems, viewer, low, high + 1uL);
+                    introsort_heapsort(access, low, high + 1uL);
                 else
                 {
-                    auto pivot = median_three(elems, viewer, low, low + (N / 2uL), high);
-                    elems->swap_elems(pivot, high);
-
-                    auto partition = introsort_partition(elems, viewer, low, high);
-                    viewer->mark(partition, sf::Color::Green);
-                    introsort_impl(elems, viewer, low, partition, maxdepth - 1uL);
-                    introsort_impl(elems, viewer, partition, high, maxdepth - 1uL);
-                    viewer->unmark(partition);
+                    auto pivot = median_three(access, low, low + (N / 2uL), high);
+                    access.swap_elems(pivot, high);
+
+                    auto partition = introsort_partition(access, low, high);
+                    access.mark(partition, sf::Color::Green);
+                    introsort_impl(access, low, partition, maxdepth - 1uL);
+                    introsort_impl(access, partition, high, maxdepth - 1uL);
+                    access.unmark(partition);
                 }
             }
         }
     }
 
-    auto introsort(
-        std::shared_ptr<Elements> elems,
-        std::shared_ptr<Viewer> viewer
-    ) noexcept -> void
+    template<access_policy A>
+    auto introsort(A& access) -> void
     {
-        auto N { elems->size() - 1uL };
+        if (access.size() < 2uL)
+            return;
+
+        auto N { access.size() - 1uL };
         auto maxdepth { static_cast<std::size_t>(std::log(N)) * 2uL };
 
-        if (N > 1uL)
         {
-            introsort_impl(elems, viewer, 0uL, N, maxdepth);
-            introsort_insertion(elems, viewer, 0uL, N);
+            auto phase = PhaseScope{ PerfPhase::PARTITION };
+            introsort_impl(access, 0uL, N, maxdepth);
         }
+
+        auto phase = PhaseScope{ PerfPhase::INSERTION };
+        introsort_insertion(access, 0uL, N);
     }
 
 }  /// namespace sv::algorithms
@@ -3,8 +3,8 @@
 
 #include <SFML/Graphics.hpp>
 
-#include <sv/elements.hxx>
-#include <sv/viewer.hxx>
+#include <sv/access.hxx>
+#include <sv/perf.hxx>
 
 #include <functional>
 #include <memory>
@@ -15,115 +15,118 @@ namespace sv::algorithms
 {
     namespace
     {
+        template<access_policy A>
         auto merge(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             std::size_t first,
             std::size_t middle,
             std::size_t last
-        ) noexcept -> void
+        ) -> void
         {
-            viewer->mark(first, sf::Color::Cyan);
-            viewer->mark(last, sf::Color::Yellow);
+            access.mark(first, sf::Color::Cyan);
+            access.mark(last, sf::Color::Yellow);
 
             auto first_n { middle - first + 1uL };
             auto last_n  { last - middle };
 
-            using element_type = typename decltype(elems)::element_type::element_type;
-            auto left   = std::vector<element_type>(first_n, element_type{});
-            auto right  = std::vector<element_type>(last_n,  element_type{});
+            auto left   = access.lease(first_n);
+            auto right  = access.lease(last_n);
 
             for (auto i { 0uL }; i < first_n; ++i)
             {
-                viewer->mark(first + 1uL + i, sf::Color::Red);
-                left.at(i) = elems->read(first + i);
-                viewer->unmark(first + 1uL + i);
+                access.mark(first + 1uL + i, sf::Color::Red);
+                left.write(i, access.read(first + i));
+                access.unmark(first + 1uL + i);
             }
 
             for (auto i { 0uL }; i < last_n; ++i)
             {
-                viewer->mark(middle + 1uL + i, sf::Color::Red);
-                right.at(i) = elems->read(middle + 1uL + i);
-                viewer->unmark(middle + 1uL + i);
+                access.mark(middle + 1uL + i, sf::Color::Red);
+                right.write(i, access.read(middle + 1uL + i));
+                access.unmark(middle + 1uL + i);
             }
 
+            left.mark_range(0uL, first_n, sf::Color::Cyan);
+            right.mark_range(0uL, last_n, sf::Color::Yellow);
+
             auto i { 0uL };
             auto j { 0uL };
             auto k { first };
 
             while (i < first_n && j < last_n)
             {
-                viewer->mark(k - 1uL, sf::Color::Blue);
-
-                auto&& [cpm, r, w, s] = elems->counters();
+                access.mark(k - 1uL, sf::Color::Blue);
 
-                if (left.at(i) <= right.at(j))
+                if (auto l { left.read(i) }, r { right.read(j) }; l <= r)
                 {
-                    elems->write(k, left.at(i));
+                    access.write(k, l);
+                    left.unmark(i);
                     i += 1uL;
                 }
                 else
                 {   
-                    elems->write(k, right.at(j));
+                    access.write(k, r);
+                    right.unmark(j);
                     j += 1uL;
                 }
 
-                cpm += 1uL;
-                viewer->unmark(k - 1uL);
+                access.count_comparisons();
+                access.unmark(k - 1uL);
                 k += 1uL;
 
             }
 
             while (i < first_n)
             {
-                viewer->mark(k - 1uL, sf::Color::Blue);
-                elems->write(k, left.at(i));
+                access.mark(k - 1uL, sf::Color::Blue);
+                access.write(k, left.read(i));
+                left.unmark(i);
                 i += 1uL;
-                viewer->unmark(k - 1uL);
+                access.unmark(k - 1uL);
                 k += 1uL;
             }
 
             while (j < last_n)
             {
-                viewer->mark(k - 1uL, sf::Color::Blue);
-                elems->write(k, right.at(j));
+                access.mark(k - 1uL, sf::Color::Blue);
+                access.write(k, right.read(j));
+                right.unmark(j);
                 j += 1uL;
-                viewer->unmark(k - 1uL);
+                access.unmark(k - 1uL);
                 k += 1uL;
             }
 
-            viewer->unmark(first);
-            viewer->unmark(last);
+            access.unmark(first);
+            access.unmark(last);
         }
 
+        template<access_policy A>
         auto mergesort_impl(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             std::size_t first,
             std::size_t last
-        ) noexcept -> void
+        ) -> void
         {
             if (first >= last)
                 return;
 
             auto middle { (first + last) / 2uL };
 
-            mergesort_impl(elems, viewer, first, middle);
-            mergesort_impl(elems, viewer, middle + 1uL, last);
+            mergesort_impl(access, first, middle);
+            mergesort_impl(access, middle + 1uL, last);
 
-            merge(elems, viewer, first, middle, last);
+            merge(access, first, middle, last);
         }
     }
 
-    auto mergesort(
-        std::shared_ptr<Elements> elems,
-        std::shared_ptr<Viewer> viewer
-    ) noexcept -> void
+    template<access_policy A>
+    auto mergesort(A& access) -> void
     {
         auto left  { 0uL };
-        auto right { elems->size() - 1 };
+        auto right { access.size() - 1 };
 
-        mergesort_impl(elems, viewer, left, right);
+        auto phase = PhaseScope{ PerfPhase::MERGE };
+        mergesort_impl(access, left, right);
     }
 
 }  /// namespace sv::algorithms
@@ -3,71 +3,68 @@
 
 #include <SFML/Graphics.hpp>
 
-#include <sv/elements.hxx>
-#include <sv/viewer.hxx>
+#include <sv/access.hxx>
 
 namespace sv::algorithms
 {
     namespace
     {
+        template<access_policy A>
         auto pancake_max(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             std::size_t first,
             std::size_t last
-        ) noexcept -> std::size_t
+        ) -> std::size_t
         {
             auto maxidx { first };
 
             for (; first < last; ++first)
             {
-                viewer->mark(first, sf::Color::Yellow);
+                access.mark(first, sf::Color::Yellow);
 
-                if (elems->compare(first, maxidx, std::ranges::greater{}))
+                if (access.compare(first, maxidx, std::ranges::greater{}))
                     maxidx = first;
 
-                viewer->unmark(first);
+                access.unmark(first);
             }
 
             return maxidx;
         }
 
+        template<access_policy A>
         auto pancake_reverse(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             std::size_t first,
             std::size_t last
-        ) noexcept -> void
+        ) -> void
         {
             if (first == last)
                 return;
 
             for (; first < last; ++first, --last)
             {
-                viewer->mark(first, sf::Color::Blue);
-                viewer->mark(last, sf::Color::Blue);
+                access.mark(first, sf::Color::Blue);
+                access.mark(last, sf::Color::Blue);
 
-                elems->swap_elems(first, last);
+                access.swap_elems(first, last);
 
-                viewer->unmark(first);
-                viewer->unmark(last);
+                access.unmark(first);
+                access.unmark(last);
             }
         }
     }
 
-    auto pancakesort(
-        std::shared_ptr<Elements> elems,
-        std::shared_ptr<Viewer> viewer
-    ) noexcept -> void
+    template<access_policy A>
+    auto pancakesort(A& access) -> void
     {
-        for (auto n { elems->size() }; n > 1uL; --n)
+        for (auto n { access.size() }; n > 1uL; --n)
         {
-            auto maxidx { pancake_max(elems, viewer, 0uL, n) };
+            auto maxidx { pancake_max(access, 0uL, n) };
 
             if (maxidx != n)
             {
-                pancake_reverse(elems, viewer, 0uL, maxidx);
-                pancake_reverse(elems, viewer, 0uL, n - 1uL);
+                pancake_reverse(access, 0uL, maxidx);
+                pancake_reverse(access, 0uL, n - 1uL);
             }
         }
     }
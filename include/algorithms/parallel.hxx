@@ -0,0 +1,54 @@
+#ifndef SV_ALGORITHMS_PARALLEL
+#   define SV_ALGORITHMS_PARALLEL
+
+#include <SFML/Graphics.hpp>
+
+#include <sv/thread_pool.hxx>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace sv::algorithms
+{
+    namespace
+    {
+        /// Mark colour of the calling pool worker so every partition
+        /// shows which worker owns it. Threads outside the pool (the
+        /// sorter thread helping while it waits) are grey.
+        auto worker_colour()
+            -> sf::Color
+        {
+            static const auto palette = std::array{
+                sf::Color(230,  25,  75),
+                sf::Color( 60, 180,  75),
+                sf::Color(255, 225,  25),
+                sf::Color(  0, 130, 200),
+                sf::Color(245, 130,  48),
+                sf::Color(145,  30, 180),
+                sf::Color( 70, 240, 240),
+                sf::Color(240,  50, 230),
+                sf::Color(210, 245,  60),
+                sf::Color(250, 190, 212),
+                sf::Color(  0, 128, 128),
+                sf::Color(220, 190, 255),
+                sf::Color(170, 110,  40),
+                sf::Color(128,   0,   0),
+                sf::Color(170, 255, 195),
+                sf::Color(  0,   0, 128)
+            };
+
+            auto w { parallel::ThreadPool::current() };
+            return w == parallel::ThreadPool::npos ? sf::Color(128, 128, 128) : palette[w % palette.size()];
+        }
+
+        /// Ranges smaller than this are sorted by a single worker rather
+        /// than forked, giving every worker a few pieces to steal.
+        auto parallel_cutoff(std::size_t N)
+            -> std::size_t
+        { return std::max(N / (parallel::pool().size() * 8uL), 16uL); }
+    }
+
+}  /// namespace sv::algorithms
+
+#endif  // SV_ALGORITHMS_PARALLEL
@@ -0,0 +1,143 @@
+#ifndef SV_ALGORITHMS_PARALLEL_INTRO_SORT
+#   define SV_ALGORITHMS_PARALLEL_INTRO_SORT
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithms/introsort.hxx>
+#include <algorithms/parallel.hxx>
+#include <algorithms/parallel_quicksort.hxx>
+
+#include <sv/access.hxx>
+#include <sv/thread_pool.hxx>
+
+#include <bit>
+#include <functional>
+#include <memory>
+#include <ranges>
+
+namespace sv::algorithms
+{
+    namespace
+    {
+        template<access_policy A>
+        auto parallel_sift_down(
+            A& access,
+            long long low,
+            long long N,
+            long long root
+        ) -> void
+        {
+            for (;;)
+            {
+                auto max   { root };
+                auto left  { 2LL * root + 1LL };
+                auto right { 2LL * root + 2LL };
+
+                if (left < N && access.compare(low + left, low + max, std::ranges::greater{}))
+                    max = left;
+
+                if (right < N && access.compare(low + right, low + max, std::ranges::greater{}))
+                    max = right;
+
+                if (max == root)
+                    return;
+
+                access.swap_elems(low + root, low + max);
+                root = max;
+            }
+        }
+
+        /// Heapsort of `[low, high]` once a partition has recursed too
+        /// deep, keeping the worst case at O(nlog(n)).
+        template<access_policy A>
+        auto parallel_heapsort(
+            A& access,
+            long long low,
+            long long high
+        ) -> void
+        {
+            auto N { high - low + 1LL };
+
+            for (auto i { N / 2LL - 1LL }; i >= 0LL; --i)
+                parallel_sift_down(access, low, N, i);
+
+            for (auto i { N - 1LL }; i > 0LL; --i)
+            {
+                access.mark(low + i, sf::Color::Magenta);
+                access.swap_elems(low, low + i);
+                parallel_sift_down(access, low, i, 0LL);
+            }
+        }
+
+        template<access_policy A>
+        auto parallel_introsort_impl(
+            A& access,
+            long long low,
+            long long high,
+            std::size_t maxdepth,
+            long long cutoff
+        ) -> void
+        {
+            if (low >= high)
+                return;
+
+            auto colour { worker_colour() };
+            auto N      { high - low + 1LL };
+
+            if (N <= 16LL)
+            {
+                introsort_insertion(access, low, high);
+                access.mark_range(low, high + 1LL, colour);
+                return;
+            }
+
+            access.mark_range(low, high + 1LL, colour);
+
+            if (maxdepth == 0uL)
+            {
+                parallel_heapsort(access, low, high);
+                access.mark_range(low, high + 1LL, colour);
+                return;
+            }
+
+            auto pivot = median_three(access, low, low + (N / 2LL), high);
+            access.swap_elems(pivot, high);
+
+            auto partition = parallel_partition(access, low, high, colour);
+
+            if (N < cutoff)
+            {
+                parallel_introsort_impl(access, low, partition - 1LL, maxdepth - 1uL, cutoff);
+                parallel_introsort_impl(access, partition + 1LL, high, maxdepth - 1uL, cutoff);
+                return;
+            }
+
+            auto group = parallel::TaskGroup{};
+            group.run([=, &access] { parallel_introsort_impl(access, low, partition - 1LL, maxdepth - 1uL, cutoff); });
+            parallel_introsort_impl(access, partition + 1LL, high, maxdepth - 1uL, cutoff);
+            group.wait();
+        }
+    }
+
+    template<access_policy A>
+    auto parallel_introsort(A& access) -> void
+    {
+        auto N { access.size() };
+
+        if (N < 2uL)
+            return;
+
+        parallel::pool().reset_stats();
+        parallel_introsort_impl(
+            access,
+            0LL,
+            static_cast<long long>(N) - 1LL,
+            2uL * static_cast<std::size_t>(std::bit_width(N) - 1),
+            static_cast<long long>(parallel_cutoff(N))
+        );
+        access.unmark_range(0uL, N);
+    }
+
+}  /// namespace sv::algorithms
+
+#endif  // SV_ALGORITHMS_PARALLEL_INTRO_SORT
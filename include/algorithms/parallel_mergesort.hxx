@@ -0,0 +1,146 @@
+#ifndef SV_ALGORITHMS_PARALLEL_MERGE_SORT
+#   define SV_ALGORITHMS_PARALLEL_MERGE_SORT
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithms/mergesort.hxx>
+#include <algorithms/parallel.hxx>
+
+#include <sv/access.hxx>
+#include <sv/thread_pool.hxx>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace sv::algorithms
+{
+    namespace
+    {
+        /// Writes outputs `[d0, d1)` of the stable merge of the buffered
+        /// runs `buffer[0, nl)` and `buffer[nl, N)` to `first + d`. The
+        /// starting split is found by binary search along the diagonal
+        /// (merge path), so chunks can be merged independently.
+        template<access_policy A>
+        auto parallel_merge_chunk(
+            A& access,
+            const typename A::lease_type& buffer,
+            std::size_t nl,
+            std::size_t first,
+            std::size_t d0,
+            std::size_t d1
+        ) -> void
+        {
+            auto colour { worker_colour() };
+            auto nr     { buffer.size() - nl };
+            auto lo     { d0 > nr ? d0 - nr : 0uL };
+            auto hi     { std::min(d0, nl) };
+
+            while (lo < hi)
+            {
+                auto m { (lo + hi) / 2uL };
+                access.count_comparisons();
+
+                if (buffer.read(m) <= buffer.read(nl + d0 - m - 1uL))
+                    lo = m + 1uL;
+                else
+                    hi = m;
+            }
+
+            auto i { lo };
+            auto j { d0 - lo };
+
+            for (auto d { d0 }; d < d1; ++d)
+            {
+                auto take_left { j >= nr || (i < nl && buffer.read(i) <= buffer.read(nl + j)) };
+
+                if (i < nl && j < nr)
+                    access.count_comparisons();
+
+                access.mark(first + d, colour);
+                access.write(first + d, take_left ? buffer.read(i++) : buffer.read(nl + j++));
+            }
+        }
+
+        /// Merges `[first, middle]` and `[middle + 1, last]`, splitting
+        /// both the copy out and the merge back across the pool.
+        template<access_policy A>
+        auto parallel_merge(
+            A& access,
+            std::size_t first,
+            std::size_t middle,
+            std::size_t last,
+            std::size_t cutoff
+        ) -> void
+        {
+            auto N      { last - first + 1uL };
+            auto chunks { std::clamp(N / cutoff, 1uL, parallel::pool().size()) };
+            auto buffer = access.lease(N);
+
+            auto split = [&](auto&& f)
+            {
+                auto group = parallel::TaskGroup{};
+
+                for (auto c { 1uL }; c < chunks; ++c)
+                    group.run([&f, c, N, chunks] { f(c * N / chunks, (c + 1uL) * N / chunks); });
+
+                f(0uL, N / chunks);
+                group.wait();
+            };
+
+            split([&](std::size_t d0, std::size_t d1)
+            {
+                for (auto d { d0 }; d < d1; ++d)
+                    buffer.write(d, access.read(first + d));
+            });
+
+            split([&](std::size_t d0, std::size_t d1)
+            { parallel_merge_chunk(access, buffer, middle - first + 1uL, first, d0, d1); });
+        }
+
+        template<access_policy A>
+        auto parallel_mergesort_impl(
+            A& access,
+            std::size_t first,
+            std::size_t last,
+            std::size_t cutoff
+        ) -> void
+        {
+            if (first >= last)
+                return;
+
+            if (last - first < cutoff)
+            {
+                mergesort_impl(access, first, last);
+                access.mark_range(first, last + 1uL, worker_colour());
+                return;
+            }
+
+            auto middle { (first + last) / 2uL };
+
+            auto group = parallel::TaskGroup{};
+            group.run([=, &access] { parallel_mergesort_impl(access, first, middle, cutoff); });
+            parallel_mergesort_impl(access, middle + 1uL, last, cutoff);
+            group.wait();
+
+            parallel_merge(access, first, middle, last, cutoff);
+        }
+    }
+
+    template<access_policy A>
+    auto parallel_mergesort(A& access) -> void
+    {
+        auto N { access.size() };
+
+        if (N < 2uL)
+            return;
+
+        parallel::pool().reset_stats();
+        parallel_mergesort_impl(access, 0uL, N - 1uL, parallel_cutoff(N));
+        access.unmark_range(0uL, N);
+    }
+
+}  /// namespace sv::algorithms
+
+#endif  // SV_ALGORITHMS_PARALLEL_MERGE_SORT
@@ -0,0 +1,111 @@
+#ifndef SV_ALGORITHMS_PARALLEL_QUICK_SORT
+#   define SV_ALGORITHMS_PARALLEL_QUICK_SORT
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithms/introsort.hxx>
+#include <algorithms/parallel.hxx>
+
+#include <sv/access.hxx>
+#include <sv/thread_pool.hxx>
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace sv::algorithms
+{
+    namespace
+    {
+        /// Lomuto partition of `[low, high]` around `high`, drawn in the
+        /// owning worker's colour.
+        template<access_policy A>
+        auto parallel_partition(
+            A& access,
+            long long low,
+            long long high,
+            sf::Color colour
+        ) -> long long
+        {
+            auto i { low };
+
+            for (auto j { low }; j < high; ++j)
+            {
+                access.mark(j, sf::Color::Red);
+
+                if (access.compare(j, high))
+                {
+                    if (i != j)
+                        access.swap_elems(i, j);
+
+                    i += 1LL;
+                }
+
+                access.mark(j, colour);
+            }
+
+            access.swap_elems(i, high);
+            return i;
+        }
+
+        /// Partitions around the median of three and hands the smaller
+        /// side to the pool, then carries on with the larger one here,
+        /// so no stack ever holds more than `log2(N)` frames of it.
+        template<access_policy A>
+        auto parallel_quicksort_impl(
+            A& access,
+            long long low,
+            long long high,
+            long long cutoff
+        ) -> void
+        {
+            auto group = parallel::TaskGroup{};
+
+            while (low < high)
+            {
+                auto N { high - low + 1LL };
+                auto colour { worker_colour() };
+                access.mark_range(low, high + 1LL, colour);
+
+                auto pivot = median_three(access, low, low + (N / 2LL), high);
+                access.swap_elems(pivot, high);
+
+                auto partition = parallel_partition(access, low, high, colour);
+
+                auto [small_low, small_high] = partition - low < high - partition
+                    ? std::pair{ low, partition - 1LL }
+                    : std::pair{ partition + 1LL, high };
+
+                if (N < cutoff)
+                    parallel_quicksort_impl(access, small_low, small_high, cutoff);
+                else
+                    group.run([=, &access] { parallel_quicksort_impl(access, small_low, small_high, cutoff); });
+
+                if (small_low == low)
+                    low = partition + 1LL;
+                else
+                    high = partition - 1LL;
+            }
+
+            group.wait();
+        }
+    }
+
+    template<access_policy A>
+    auto parallel_quicksort(A& access) -> void
+    {
+        auto N { access.size() };
+
+        parallel::pool().reset_stats();
+        parallel_quicksort_impl(
+            access,
+            0LL,
+            static_cast<long long>(N) - 1LL,
+            static_cast<long long>(parallel_cutoff(N))
+        );
+        access.unmark_range(0uL, N);
+    }
+
+}  /// namespace sv::algorithms
+
+#endif  // SV_ALGORITHMS_PARALLEL_QUICK_SORT
@@ -3,73 +3,72 @@
 
 #include <SFML/Graphics.hpp>
 
-#include <sv/elements.hxx>
-#include <sv/viewer.hxx>
+#include <sv/access.hxx>
+#include <sv/perf.hxx>
 
 namespace sv::algorithms
 {
     namespace
     {   
+        template<access_policy A>
         auto quicksort_partition(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             long long low,
             long long high
-        ) noexcept -> long long
+        ) -> long long
         {
-            auto N { static_cast<long long>(elems->size()) - 1LL };
+            auto N { static_cast<long long>(access.size()) - 1LL };
             auto i { low - 1LL };
             
             for (auto j { low }; j < high; ++j)
             {
-                viewer->mark_range(std::ranges::clamp(i, 0LL, N), j - 1LL, sf::Color::Blue);
-                viewer->mark(j - 1LL, sf::Color::Red);
+                access.mark_range(std::ranges::clamp(i, 0LL, N), j - 1LL, sf::Color::Blue);
+                access.mark(j - 1LL, sf::Color::Red);
 
-                if (elems->compare(j, high))
+                if (access.compare(j, high))
                 {
                     i += 1LL;
                     
                     if (i != j)
-                        elems->swap_elems(i, j);
+                        access.swap_elems(i, j);
                 }
 
-                viewer->unmark_range(std::ranges::clamp(i - 1LL, 0LL, N), j);
+                access.unmark_range(std::ranges::clamp(i - 1LL, 0LL, N), j);
             }
 
-            elems->swap_elems(i + 1LL, high);
+            access.swap_elems(i + 1LL, high);
             return i + 1LL;
         }
 
+        template<access_policy A>
         auto quicksort_impl(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             long long low,
             long long high
-        ) noexcept -> void
+        ) -> void
         {
             if (low < high)
             {
-                auto pivot = quicksort_partition(elems, viewer, low, high);
+                auto pivot = quicksort_partition(access, low, high);
                 
-                viewer->mark(pivot, sf::Color::Green);
+                access.mark(pivot, sf::Color::Green);
 
-                quicksort_impl(elems, viewer, low, pivot - 1LL);
-                quicksort_impl(elems, viewer, pivot + 1LL, high);
+                quicksort_impl(access, low, pivot - 1LL);
+                quicksort_impl(access, pivot + 1LL, high);
 
-                viewer->unmark(pivot);
+                access.unmark(pivot);
             }
         }
     }
 
-    auto quicksort(
-        std::shared_ptr<Elements> elems,
-        std::shared_ptr<Viewer> viewer
-    ) noexcept -> void
+    template<access_policy A>
+    auto quicksort(A& access) -> void
     {
         auto low  { 0LL };
-        auto high { elems->size() - 1 };
+        auto high { access.size() - 1 };
 
-        quicksort_impl(elems, viewer, low, high);
+        auto phase = PhaseScope{ PerfPhase::PARTITION };
+        quicksort_impl(access, low, high);
     }
 
 }  /// namespace sv::algorithms
@@ -3,92 +3,107 @@
 
 #include <SFML/Graphics.hpp>
 
-#include <sv/elements.hxx>
-#include <sv/viewer.hxx>
+#include <sv/access.hxx>
+#include <sv/keys.hxx>
 
-#include <functional>
-#include <ranges>
-#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
 
 namespace sv::algorithms
 {
     namespace
     {
-        auto radix_max(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer
-        ) noexcept -> sv::Elements::element_type
+        /// Buckets per digit; each digit is one byte of the key's bits.
+        constexpr auto radix_bins { 256uL };
+
+        template<typename T>
+        auto radix_digit(const T& value, std::size_t digit) noexcept
+            -> std::size_t
+        { return static_cast<std::size_t>((radix_bits(value) >> (8uL * digit)) & 0xFFu); }
+
+        /// Fills the histogram of every digit in one pass over the elements.
+        template<access_policy A>
+        auto radix_histograms(
+            A& access,
+            std::size_t* counts
+        ) -> void
         {
-            auto maxidx { 0uL };
+            constexpr auto digits { sizeof(radix_type_t<typename A::element_type>) };
 
-            for (auto i { 0uL }; i < elems->size(); ++i)
+            for (auto i { 0uL }; i < access.size(); ++i)
             {
-                viewer->mark(i, sf::Color::Yellow);
+                access.mark(i, sf::Color::Yellow);
+                auto value { access.read(i) };
 
-                if (elems->compare(i, maxidx, std::ranges::greater{}))
-                    maxidx = i;
+                for (auto d { 0uL }; d < digits; ++d)
+                    counts[d * radix_bins + radix_digit(value, d)] += 1uL;
 
-                viewer->unmark(i);
+                access.unmark(i);
             }
-
-            return elems->read(maxidx);
         }
+    }
 
-        auto radix_impl(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
-            int place
-        ) noexcept -> void
-        {
-            auto s { elems->size() };
-
-            using element_type = sv::Elements::element_type;
-            auto output = std::vector<element_type>(s, element_type{});
-            auto count  = std::vector<std::size_t>(10uL, std::size_t{});
+    /// Base-256 LSD radix sort over the order-preserving bits of the key.
+    /// Passes alternate between the elements and one auxiliary buffer,
+    /// and a digit every key shares is skipped without moving anything.
+    template<access_policy A>
+    auto radixsort(A& access) -> void
+    {
+        constexpr auto digits { sizeof(radix_type_t<typename A::element_type>) };
 
-            for (auto i { 0uL }; i < s; ++i)
-            {
-                viewer->mark(i, sf::Color::Red);
-                count.at((static_cast<unsigned int>(elems->read(i)) / place) % 10) += 1uL;
-                viewer->unmark(i);
-            }
+        auto N { access.size() };
 
-            for (auto i { 1uL }; i < 10; ++i)
-                count.at(i) += count.at(i - 1uL);
+        if (N < 2uL)
+            return;
 
-            for (auto i { 9uL }; i > 0uL; --i)
-                count.at(i) = count.at(i - 1uL);
+        auto counts = lease_table<std::size_t>(access, digits * radix_bins);
+        radix_histograms(access, counts.data());
 
-            count.at(0uL) = 0uL;
+        auto buffer = access.lease(N);
+        auto in_buffer { false };
 
-            for (auto i { 0uL }; i < s; ++i)
-            {
-                viewer->mark(i, sf::Color::Red);
-                auto val { static_cast<unsigned int>(elems->read(i)) };
-                auto digit { (val / place) % 10 };
-                output.at(count.at(digit)) = static_cast<element_type>(val);
-                count.at(digit) += 1uL;
-                viewer->unmark(i);
-            }
+        for (auto d { 0uL }; d < digits; ++d)
+        {
+            auto count { counts.data() + d * radix_bins };
+
+            if (std::find(count, count + radix_bins, N) != count + radix_bins)
+                continue;
+
+            auto sum { 0uL };
+
+            for (auto b { 0uL }; b < radix_bins; ++b)
+                sum += std::exchange(count[b], sum);
+
+            if (!in_buffer)
+                for (auto i { 0uL }; i < N; ++i)
+                {
+                    access.mark(i, sf::Color::Red);
+                    auto value { access.read(i) };
+                    buffer.write(count[radix_digit(value, d)]++, value);
+                    access.unmark(i);
+                }
+            else
+                for (auto i { 0uL }; i < N; ++i)
+                {
+                    auto value { buffer.read(i) };
+                    auto k { count[radix_digit(value, d)]++ };
+
+                    access.mark(k, sf::Color::Blue);
+                    access.write(k, value);
+                    access.unmark(k);
+                }
+
+            in_buffer = !in_buffer;
+        }
 
-            for (auto i { 0uL }; i < s; ++i)
+        if (in_buffer)
+            for (auto k { 0uL }; k < N; ++k)
             {
-                viewer->mark(i, sf::Color::Blue);
-                elems->write(i, output.at(i));
-                viewer->unmark(i);
+                access.mark(k, sf::Color::Blue);
+                access.write(k, buffer.read(k));
+                access.unmark(k);
             }
-        }
-    }
-
-    auto radixsort(
-        std::shared_ptr<Elements> elems,
-        std::shared_ptr<Viewer> viewer
-    ) noexcept -> void
-    {
-        auto max { static_cast<unsigned int>(radix_max(elems, viewer)) };
-
-        for (auto p { 1u }; (max / p) > 0u; p *= 10u)
-            radix_impl(elems, viewer, p);
     }
 
 }  /// namespace sv::algorithms
@@ -3,37 +3,34 @@
 
 #include <SFML/Graphics.hpp>
 
-#include <sv/elements.hxx>
-#include <sv/viewer.hxx>
+#include <sv/access.hxx>
 
 namespace sv::algorithms
 {
-    auto selectionsort(
-        std::shared_ptr<Elements> elems,
-        std::shared_ptr<Viewer> viewer
-    ) noexcept -> void
+    template<access_policy A>
+    auto selectionsort(A& access) -> void
     {
         auto minidx { 0uL };
 
-        for (auto i { 0uL }, n { elems->size() }; i < n; ++i)
+        for (auto i { 0uL }, n { access.size() }; i < n; ++i)
         {
             minidx = i;
 
             for (auto j { i + 1uL }; j < n; ++j)
             {
-                viewer->mark(j, sf::Color::Yellow);
+                access.mark(j, sf::Color::Yellow);
                 
-                if (elems->compare(j, minidx))
+                if (access.compare(j, minidx))
                     minidx = j;
 
-                viewer->unmark(j);
+                access.unmark(j);
             }
 
             if (minidx != i)
             {
-                viewer->mark(i, sf::Color::Blue);
-                elems->swap_elems(i, minidx);
-                viewer->unmark(i);
+                access.mark(i, sf::Color::Blue);
+                access.swap_elems(i, minidx);
+                access.unmark(i);
             }
         }
     }
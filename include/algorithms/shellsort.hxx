@@ -3,39 +3,35 @@
 
 #include <SFML/Graphics.hpp>
 
-#include <sv/elements.hxx>
-#include <sv/viewer.hxx>
+#include <sv/access.hxx>
 
 #include <functional>
 #include <ranges>
 
 namespace sv::algorithms
 {
-    auto shellsort(
-        std::shared_ptr<Elements> elems,
-        std::shared_ptr<Viewer> viewer
-    ) noexcept -> void
+    template<access_policy A>
+    auto shellsort(A& access) -> void
     {
-        auto N { elems->size() };
+        auto N { access.size() };
 
         for (auto gap { N / 2uL }; gap > 0uL; gap /= 2uL)
             for (auto i { gap }; i < N; i += 1uL)
             {
-                viewer->mark(i, sf::Color::Red);
-                auto&& [cp, rd, wr, sw] = elems->counters();
+                access.mark(i, sf::Color::Red);
 
-                auto t { elems->read(i) };
+                auto t { access.read(i) };
                 auto j { 0uL };
-                for (j = i; j >= gap && elems->read(j - gap) > t; j -= gap)
+                for (j = i; j >= gap && access.read(j - gap) > t; j -= gap)
                 {
-                    cp += 1uL;
-                    elems->write(j, elems->read(j - gap));
+                    access.count_comparisons();
+                    access.write(j, access.read(j - gap));
                 }
 
-                viewer->mark(j, sf::Color::Blue);
-                elems->write(j, t);
-                viewer->unmark(j);
-                viewer->unmark(i);
+                access.mark(j, sf::Color::Blue);
+                access.write(j, t);
+                access.unmark(j);
+                access.unmark(i);
             }
     }
 
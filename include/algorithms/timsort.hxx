@@ -1,10 +1,10 @@
 #ifndef SV_ALGORITHMS_TIM_SORT
-#   define SV_ALGORITHMS_TIm_SORT
+#   define SV_ALGORITHMS_TIM_SORT
 
 #include <SFML/Graphics.hpp>
 
-#include <sv/elements.hxx>
-#include <sv/viewer.hxx>
+#include <sv/access.hxx>
+#include <sv/perf.hxx>
 
 #include <functional>
 #include <ranges>
@@ -13,133 +13,139 @@ namespace sv::algorithms
 {
     namespace
     {
+        template<access_policy A>
         auto timsort_insertion(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             long long low,
             long long high
-        ) noexcept -> void
+        ) -> void
         {
             for (auto i { low + 1LL }; i <= high; ++i)
             {
-                viewer->mark(i, sf::Color::Yellow);
-                auto current { elems->read(i) };
+                access.mark(i, sf::Color::Yellow);
+                auto current { access.read(i) };
                 auto j { static_cast<long long>(i) - 1LL };
 
-                auto&& [cmp, r, w, s] = elems->counters();
-
-                while (j >= low && elems->read(j) > current)
+                while (j >= low && access.read(j) > current)
                 {
-                    viewer->mark(j + 1LL, sf::Color::Cyan);
-                    elems->write(j + 1LL, elems->read(j));
-                    viewer->unmark(j + 1LL);
+                    access.mark(j + 1LL, sf::Color::Cyan);
+                    access.write(j + 1LL, access.read(j));
+                    access.unmark(j + 1LL);
                     j -= 1LL;
-                    cmp += 1uL;
+                    access.count_comparisons();
                 }
 
-                cmp += 1uL;
-                elems->write(j + 1LL, current);
-                viewer->unmark(i);
+                access.count_comparisons();
+                access.write(j + 1LL, current);
+                access.unmark(i);
             }
         }
     
+        template<access_policy A>
         auto timsort_merge(
-            std::shared_ptr<Elements> elems,
-            std::shared_ptr<Viewer> viewer,
+            A& access,
             std::size_t first,
             std::size_t middle,
             std::size_t last
-        ) noexcept -> void
+        ) -> void
         {
-            viewer->mark(first, sf::Color::Cyan);
-            viewer->mark(last, sf::Color::Yellow);
+            access.mark(first, sf::Color::Cyan);
+            access.mark(last, sf::Color::Yellow);
 
             auto first_n { middle - first + 1uL };
             auto last_n  { last - middle };
 
-            using element_type = typename decltype(elems)::element_type::element_type;
-            auto left   = std::vector<element_type>(first_n, element_type{});
-            auto right  = std::vector<element_type>(last_n,  element_type{});
+            auto left   = access.lease(first_n);
+            auto right  = access.lease(last_n);
 
             for (auto i { 0uL }; i < first_n; ++i)
             {
-                viewer->mark(first + 1uL + i, sf::Color::Red);
-                left.at(i) = elems->read(first + i);
-                viewer->unmark(first + 1uL + i);
+                access.mark(first + 1uL + i, sf::Color::Red);
+                left.write(i, access.read(first + i));
+                access.unmark(first + 1uL + i);
             }
 
             for (auto i { 0uL }; i < last_n; ++i)
             {
-                viewer->mark(middle + 1uL + i, sf::Color::Red);
-                right.at(i) = elems->read(middle + 1uL + i);
-                viewer->unmark(middle + 1uL + i);
+                access.mark(middle + 1uL + i, sf::Color::Red);
+                right.write(i, access.read(middle + 1uL + i));
+                access.unmark(middle + 1uL + i);
             }
 
+            left.mark_range(0uL, first_n, sf::Color::Cyan);
+            right.mark_range(0uL, last_n, sf::Color::Yellow);
+
             auto i { 0uL };
             auto j { 0uL };
             auto k { first };
 
             while (i < first_n && j < last_n)
             {
-                viewer->mark(k - 1uL, sf::Color::Blue);
-
-                auto&& [cpm, r, w, s] = elems->counters();
+                access.mark(k - 1uL, sf::Color::Blue);
 
-                if (left.at(i) <= right.at(j))
+                if (auto l { left.read(i) }, r { right.read(j) }; l <= r)
                 {
-                    elems->write(k, left.at(i));
+                    access.write(k, l);
+                    left.unmark(i);
                     i += 1uL;
                 }
                 else
                 {   
-                    elems->write(k, right.at(j));
+                    access.write(k, r);
+                    right.unmark(j);
                     j += 1uL;
                 }
 
-                cpm += 1uL;
-                viewer->unmark(k - 1uL);
+                access.count_comparisons();
+                access.unmark(k - 1uL);
                 k += 1uL;
 
             }
 
             while (i < first_n)
             {
-                viewer->mark(k - 1uL, sf::Color::Blue);
-                elems->write(k, left.at(i));
+                access.mark(k - 1uL, sf::Color::Blue);
+                access.write(k, left.read(i));
+                left.unmark(i);
                 i += 1uL;
-                viewer->unmark(k - 1uL);
+                access.unmark(k - 1uL);
                 k += 1uL;
             }
 
             while (j < last_n)
             {
-                viewer->mark(k - 1uL, sf::Color::Blue);
-                elems->write(k, right.at(j));
+                access.mark(k - 1uL, sf::Color::Blue);
+                access.write(k, right.read(j));
+                right.unmark(j);
                 j += 1uL;
-                viewer->unmark(k - 1uL);
+                access.unmark(k - 1uL);
                 k += 1uL;
             }
 
-            viewer->unmark(first);
-            viewer->unmark(last);
+            access.unmark(first);
+            access.unmark(last);
         }
     }
 
-    auto timsort(
-        std::shared_ptr<Elements> elems,
-        std::shared_ptr<Viewer> viewer
-    ) noexcept -> void
+    template<access_policy A>
+    auto timsort(A& access) -> void
     {
         constexpr auto runs { 32uL };
-        auto N { elems->size() };
-        
-        for (auto i { 0uL }; i < N; i += runs)
-        {   
-            viewer->mark(i, sf::Color::Magenta);
-            timsort_insertion(elems, viewer, i, std::ranges::min(i + runs - 1uL, N - 1uL));
-            viewer->unmark(i);
+        auto N { access.size() };
+
+        {
+            auto phase = PhaseScope{ PerfPhase::INSERTION };
+
+            for (auto i { 0uL }; i < N; i += runs)
+            {
+                access.mark(i, sf::Color::Magenta);
+                timsort_insertion(access, i, std::ranges::min(i + runs - 1uL, N - 1uL));
+                access.unmark(i);
+            }
         }
 
+        auto phase = PhaseScope{ PerfPhase::MERGE };
+
         for (auto size { runs }; size < N; size *= 2uL)
             for (auto left { 0uL }; left < N; left += 2uL * size)
             {
@@ -147,7 +153,7 @@ namespace sv::algorithms
                 auto right = std::ranges::min(left + (2uL * size) - 1uL, N - 1uL);
 
                 if (mid < right)
-                    timsort_merge(elems, viewer, left, mid, right);
+                    timsort_merge(access, left, mid, right);
             }
     }
 
@@ -0,0 +1,134 @@
+#ifndef SV_ALGORITHMS_VECTORIZED_BUCKET_SORT
+#   define SV_ALGORITHMS_VECTORIZED_BUCKET_SORT
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithms/vectorized_introsort.hxx>
+
+#include <sv/access.hxx>
+#include <sv/keys.hxx>
+#include <sv/simd.hxx>
+
+#include <algorithm>
+#include <numeric>
+#include <span>
+
+namespace sv::algorithms
+{
+    namespace
+    {
+        /// Elements per block read in the scans.
+        constexpr auto vectorized_chunk { 1024uL };
+
+        /// Minimum and maximum in one pass, a block at a time.
+        template<access_policy A>
+        auto vectorized_minmax(
+            A& access,
+            typename A::element_type* block
+        ) -> std::pair<typename A::element_type, typename A::element_type>
+        {
+            auto N { access.size() };
+            auto lo { access.silent_read(0uL) };
+            auto hi { lo };
+
+            for (auto i { 0uL }; i < N; i += vectorized_chunk)
+            {
+                auto n { std::min(vectorized_chunk, N - i) };
+
+                access.mark_range(i, i + n, sf::Color::Yellow);
+                access.read_block(i, std::span{ block, n });
+
+                auto [l, h] = simd::minmax(block, n);
+                lo = std::min(lo, l);
+                hi = std::max(hi, h);
+
+                access.count_comparisons(2uL * n);
+                access.unmark_range(i, i + n);
+            }
+
+            return { lo, hi };
+        }
+    }
+
+    /// Bucket sort with about 32 elements per bucket. The min and max are
+    /// found in one fused vector scan, buckets are laid out flat by a
+    /// counting pass, and each bucket is sorted by a bitonic network (or
+    /// the vectorized introsort when it overflows) and written back as
+    /// one block.
+    template<access_policy A>
+    auto vectorized_bucketsort(A& access) -> void
+    {
+        using element_type = typename A::element_type;
+
+        auto N { access.size() };
+
+        if (N < 2uL)
+            return;
+
+        auto block = access.lease(std::min(vectorized_chunk, N));
+        auto [min, max] = vectorized_minmax(access, block.data());
+
+        if (!(min < max))
+            return;
+
+        auto count  { std::max(N / 32uL, 1uL) };
+        auto scale  { static_cast<double>(count) / key_distance(max, min) };
+        auto bucket = [&](element_type v)
+        { return std::min(static_cast<std::size_t>(key_distance(v, min) * scale), count - 1uL); };
+
+        auto offsets = lease_table<std::size_t>(access, count + 1uL);
+        auto flat    = access.lease(N);
+        auto keys    = lease_table<std::size_t>(access, N);
+
+        for (auto i { 0uL }; i < N; i += vectorized_chunk)
+        {
+            auto n { std::min(vectorized_chunk, N - i) };
+
+            access.mark_range(i, i + n, sf::Color::Red);
+            access.read_block(i, std::span{ block.data(), n });
+
+            for (auto j { 0uL }; j < n; ++j)
+            {
+                flat.data()[i + j] = block.data()[j];
+                keys[i + j] = bucket(block.data()[j]);
+                offsets[keys[i + j] + 1uL] += 1uL;
+            }
+
+            access.unmark_range(i, i + n);
+        }
+
+        std::partial_sum(offsets.data(), offsets.data() + count + 1uL, offsets.data());
+
+        auto buckets = access.lease(N);
+        auto cursor  = lease_table<std::size_t>(access, count);
+        std::copy_n(offsets.data(), count, cursor.data());
+
+        for (auto i { 0uL }; i < N; ++i)
+            buckets.data()[cursor[keys[i]]++] = flat.data()[i];
+
+        for (auto b { 0uL }; b < count; ++b)
+        {
+            auto first { offsets[b] };
+            auto last  { offsets[b + 1uL] };
+            auto span  = std::span{ buckets.data() + first, last - first };
+
+            if (span.size() <= simd::network_size)
+            {
+                simd::sort_network(span.data(), span.size());
+                access.count_comparisons(simd::network_comparators(span.size()));
+            }
+            else
+            {
+                auto native = NativeAccess<element_type>{ span, access.scratch() };
+                vectorized_introsort(native);
+            }
+
+            access.mark_range(first, last, sf::Color::Blue);
+            access.write_block(first, span);
+            access.unmark_range(first, last);
+        }
+    }
+
+}  /// namespace sv::algorithms
+
+#endif  // SV_ALGORITHMS_VECTORIZED_BUCKET_SORT
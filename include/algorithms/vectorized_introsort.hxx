@@ -0,0 +1,164 @@
+#ifndef SV_ALGORITHMS_VECTORIZED_INTRO_SORT
+#   define SV_ALGORITHMS_VECTORIZED_INTRO_SORT
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithms/parallel_introsort.hxx>
+
+#include <sv/access.hxx>
+#include <sv/perf.hxx>
+#include <sv/simd.hxx>
+
+#include <algorithm>
+#include <bit>
+#include <span>
+
+namespace sv::algorithms
+{
+    namespace
+    {
+        /// Scratch for the out-of-place partition: the block being split
+        /// and the two packed halves, each with a register of slack.
+        template<access_policy A>
+        struct VectorizedBuffers
+        {
+            typename A::lease_type block;
+            typename A::lease_type left;
+            typename A::lease_type right;
+
+            explicit VectorizedBuffers(A& access)
+                : block{ access.lease(access.size()) }
+                , left{ access.lease(access.size() + simd::network_size) }
+                , right{ access.lease(access.size() + simd::network_size) }
+            { }
+        };
+
+        /// Sorts `[first, last)`, at most `simd::network_size` elements, in
+        /// one block read, one bitonic network and one block write.
+        template<access_policy A>
+        auto vectorized_network(
+            A& access,
+            typename A::element_type* block,
+            std::size_t first,
+            std::size_t last
+        ) -> void
+        {
+            auto n { last - first };
+
+            if (n < 2uL)
+                return;
+
+            auto span = std::span{ block, n };
+
+            access.mark_range(first, last, sf::Color::Cyan);
+            access.read_block(first, span);
+            simd::sort_network(span.data(), n);
+            access.count_comparisons(simd::network_comparators(n));
+            access.write_block(first, span);
+            access.unmark_range(first, last);
+        }
+
+        /// Splits `[first, last)` around `pivot` with the vector kernel,
+        /// writing the two halves back as blocks. Returns the split point.
+        template<access_policy A>
+        auto vectorized_partition(
+            A& access,
+            VectorizedBuffers<A>& buffers,
+            std::size_t first,
+            std::size_t last,
+            typename A::element_type pivot,
+            bool or_equal
+        ) -> std::size_t
+        {
+            auto n     { last - first };
+            auto block = std::span{ buffers.block.data(), n };
+
+            access.mark_range(first, last, sf::Color::Red);
+            access.read_block(first, block);
+
+            auto k { simd::partition(block.data(), n, pivot, buffers.left.data(), buffers.right.data(), or_equal) };
+            access.count_comparisons(n);
+
+            access.mark_range(first, first + k, sf::Color::Blue);
+            access.write_block(first, std::span{ buffers.left.data(), k });
+            access.mark_range(first + k, last, sf::Color::Magenta);
+            access.write_block(first + k, std::span{ buffers.right.data(), n - k });
+            access.unmark_range(first, last);
+
+            return first + k;
+        }
+
+        template<access_policy A>
+        auto vectorized_introsort_impl(
+            A& access,
+            VectorizedBuffers<A>& buffers,
+            std::size_t first,
+            std::size_t last,
+            std::size_t maxdepth
+        ) -> void
+        {
+            while (last - first > simd::network_size)
+            {
+                if (maxdepth == 0uL)
+                {
+                    parallel_heapsort(access, static_cast<long long>(first), static_cast<long long>(last) - 1LL);
+                    access.unmark_range(first, last);
+                    return;
+                }
+
+                maxdepth -= 1uL;
+
+                auto a { access.read(first) };
+                auto b { access.read(first + (last - first) / 2uL) };
+                auto c { access.read(last - 1uL) };
+                auto pivot { std::max(std::min(a, b), std::min(std::max(a, b), c)) };
+                access.count_comparisons(3uL);
+
+                auto split { vectorized_partition(access, buffers, first, last, pivot, false) };
+
+                /// Nothing was below the pivot, so it is the minimum: peel
+                /// off every copy of it instead of recursing on them.
+                if (split == first)
+                {
+                    first = vectorized_partition(access, buffers, first, last, pivot, true);
+                    continue;
+                }
+
+                access.mark(split, sf::Color::Green);
+
+                if (split - first < last - split)
+                {
+                    vectorized_introsort_impl(access, buffers, first, split, maxdepth);
+                    access.unmark(split);
+                    first = split;
+                }
+                else
+                {
+                    vectorized_introsort_impl(access, buffers, split, last, maxdepth);
+                    access.unmark(split);
+                    last = split;
+                }
+            }
+
+            vectorized_network(access, buffers.block.data(), first, last);
+        }
+    }
+
+    /// Introsort whose partitions are split by a vector kernel and whose
+    /// ranges of up to 64 elements are finished by a bitonic network.
+    template<access_policy A>
+    auto vectorized_introsort(A& access) -> void
+    {
+        auto N { access.size() };
+
+        if (N < 2uL)
+            return;
+
+        auto buffers = VectorizedBuffers<A>{ access };
+        auto phase = PhaseScope{ PerfPhase::PARTITION };
+        vectorized_introsort_impl(access, buffers, 0uL, N, 2uL * static_cast<std::size_t>(std::bit_width(N) - 1));
+    }
+
+}  /// namespace sv::algorithms
+
+#endif  // SV_ALGORITHMS_VECTORIZED_INTRO_SORT
@@ -0,0 +1,93 @@
+#ifndef SV_ALGORITHMS_VECTORIZED_TIM_SORT
+#   define SV_ALGORITHMS_VECTORIZED_TIM_SORT
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithms/vectorized_introsort.hxx>
+
+#include <sv/access.hxx>
+#include <sv/perf.hxx>
+#include <sv/simd.hxx>
+
+#include <algorithm>
+#include <span>
+
+namespace sv::algorithms
+{
+    namespace
+    {
+        /// Merges the sorted runs `[first, middle)` and `[middle, last)`,
+        /// reading both as one block and writing the result back as one.
+        template<access_policy A>
+        auto vectorized_timsort_merge(
+            A& access,
+            typename A::element_type* block,
+            typename A::element_type* merged,
+            std::size_t first,
+            std::size_t middle,
+            std::size_t last
+        ) -> void
+        {
+            auto n { last - first };
+            auto m { middle - first };
+
+            access.mark_range(first, middle, sf::Color::Cyan);
+            access.mark_range(middle, last, sf::Color::Yellow);
+            access.read_block(first, std::span{ block, n });
+
+            auto i { 0uL };
+            auto j { m };
+            auto k { 0uL };
+
+            while (i < m && j < n)
+            {
+                auto take_left { !(block[j] < block[i]) };
+                merged[k++] = take_left ? block[i++] : block[j++];
+            }
+
+            access.count_comparisons(k);
+
+            std::copy(block + i, block + m, merged + k);
+            k += m - i;
+            std::copy(block + j, block + n, merged + k);
+
+            access.mark_range(first, last, sf::Color::Blue);
+            access.write_block(first, std::span{ merged, n });
+            access.unmark_range(first, last);
+        }
+    }
+
+    /// Timsort with 64 element runs sorted by a bitonic network and
+    /// block-wise merges.
+    template<access_policy A>
+    auto vectorized_timsort(A& access) -> void
+    {
+        constexpr auto runs { simd::network_size };
+        auto N { access.size() };
+
+        auto block  = access.lease(N);
+        auto merged = access.lease(N);
+
+        {
+            auto phase = PhaseScope{ PerfPhase::INSERTION };
+
+            for (auto i { 0uL }; i < N; i += runs)
+                vectorized_network(access, block.data(), i, std::min(i + runs, N));
+        }
+
+        auto phase = PhaseScope{ PerfPhase::MERGE };
+
+        for (auto size { runs }; size < N; size *= 2uL)
+            for (auto left { 0uL }; left < N; left += 2uL * size)
+            {
+                auto mid   { left + size };
+                auto right { std::min(left + 2uL * size, N) };
+
+                if (mid < right)
+                    vectorized_timsort_merge(access, block.data(), merged.data(), left, mid, right);
+            }
+    }
+
+}  /// namespace sv::algorithms
+
+#endif  // SV_ALGORITHMS_VECTORIZED_TIM_SORT
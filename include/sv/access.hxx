@@ -0,0 +1,433 @@
+#ifndef SV_ACCESS
+#   define SV_ACCESS
+
+#include <SFML/Graphics.hpp>
+
+#include <sv/elements.hxx>
+#include <sv/keys.hxx>
+#include <sv/scratch.hxx>
+#include <sv/viewer.hxx>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace sv
+{
+    /// What an algorithm may do to the elements it sorts. Every algorithm
+    /// is written once against this and instantiated either over
+    /// `InstrumentedAccess` (counters, marks, pacing, tracing) or over
+    /// `NativeAccess` (plain loads and stores, for benchmarking the same
+    /// code against the standard library).
+    template<typename A>
+    concept access_policy = requires(
+        A& access,
+        typename A::size_type idx,
+        typename A::element_type value,
+        std::span<typename A::element_type> block,
+        sf::Color colour
+    )
+    {
+        { access.size() }                                   -> std::same_as<typename A::size_type>;
+        { access.read(idx) }                                -> std::same_as<typename A::element_type>;
+        { access.silent_read(idx) }                         -> std::same_as<typename A::element_type>;
+        { access.write(idx, value) }                        -> std::same_as<void>;
+        { access.read_block(idx, block) }                   -> std::same_as<void>;
+        { access.write_block(idx, block) }                  -> std::same_as<void>;
+        { access.compare(idx, idx) }                        -> std::same_as<bool>;
+        { access.compare(idx, idx, std::ranges::greater{}) }-> std::same_as<bool>;
+        { access.swap_elems(idx, idx) }                     -> std::same_as<void>;
+        { access.count_comparisons(idx) }                   -> std::same_as<void>;
+        { access.mark(idx, colour) }                        -> std::same_as<void>;
+        { access.unmark(idx) }                              -> std::same_as<void>;
+        { access.mark_range(idx, idx, colour) }             -> std::same_as<void>;
+        { access.unmark_range(idx, idx) }                   -> std::same_as<void>;
+        { access.lease(idx) }                               -> std::same_as<typename A::lease_type>;
+        { access.scratch() }                                -> std::same_as<Scratch&>;
+    };
+
+    /// An auxiliary lease whose reads and writes are charged, paced and
+    /// drawn on the auxiliary lane like accesses to the elements.
+    class InstrumentedLease
+    {
+    public:
+
+        using value_type    = Elements::element_type;
+        using size_type     = Elements::size_type;
+
+    public:
+
+        explicit InstrumentedLease(Elements::lease_type lease, Elements& elems, Viewer& viewer) noexcept
+            : m_lease{ std::move(lease) }
+            , m_elems{ &elems }
+            , m_viewer{ &viewer }
+        { }
+
+        InstrumentedLease(InstrumentedLease&&) noexcept = default;
+
+        ~InstrumentedLease() noexcept
+        {
+            if (m_lease.drawn())
+                m_viewer->aux_unmark_range(m_lease.offset(), m_lease.offset() + m_lease.size());
+        }
+
+        auto size() const noexcept
+            -> size_type
+        { return m_lease.size(); }
+
+        /// Raw storage, for kernels working on the lease as a whole.
+        auto data() const noexcept
+            -> value_type*
+        { return m_lease.data(); }
+
+        auto read(size_type idx) const
+            -> value_type
+        { return m_elems->aux_read(m_lease, idx); }
+
+        auto write(size_type idx, value_type value) const
+            -> void
+        { m_elems->aux_write(m_lease, idx, value); }
+
+        auto mark(size_type idx, sf::Color colour) const noexcept
+            -> void
+        {
+            if (m_lease.drawn())
+                m_viewer->aux_mark(m_lease.offset() + idx, colour);
+        }
+
+        auto unmark(size_type idx) const noexcept
+            -> void
+        {
+            if (m_lease.drawn())
+                m_viewer->aux_unmark(m_lease.offset() + idx);
+        }
+
+        auto mark_range(size_type fidx, size_type eidx, sf::Color colour) const noexcept
+            -> void
+        {
+            if (m_lease.drawn())
+                m_viewer->aux_mark_range(m_lease.offset() + fidx, m_lease.offset() + eidx, colour);
+        }
+
+    private:
+        Elements::lease_type    m_lease;
+        Elements*               m_elems;
+        Viewer*                 m_viewer;
+
+    };  /// class InstrumentedLease
+
+    /// The arena `NativeAccess` leases from unless given one; one per
+    /// thread so repeated native sorts reuse their blocks.
+    inline auto native_scratch()
+        -> Scratch&
+    {
+        thread_local auto scratch = Scratch{};
+        return scratch;
+    }
+
+    /// `count` value-initialised `T`s of uninstrumented scratch, eg. for
+    /// the counts and offsets of the distribution sorts.
+    template<typename T, access_policy A>
+    auto lease_table(A& access, std::size_t count)
+        -> Scratch::Lease<T>
+    {
+        auto lease = access.scratch().template lease<T>(count);
+        std::ranges::fill(lease.span(), T{});
+        return lease;
+    }
+
+    /// Forwards to `Elements` and `Viewer`. Holds plain pointers so
+    /// recursive calls and forked tasks pass it around for free.
+    class InstrumentedAccess
+    {
+    public:
+
+        using element_type  = Elements::element_type;
+        using size_type     = Elements::size_type;
+        using lease_type    = InstrumentedLease;
+
+    public:
+
+        explicit InstrumentedAccess(Elements& elems, Viewer& viewer) noexcept
+            : m_elems{ &elems }
+            , m_viewer{ &viewer }
+        { }
+
+        auto size() const noexcept
+            -> size_type
+        { return m_elems->size(); }
+
+        auto read(size_type idx) const
+            -> element_type
+        { return m_elems->read(idx); }
+
+        auto silent_read(size_type idx) const
+            -> element_type
+        { return m_elems->silent_read(idx); }
+
+        auto write(size_type idx, element_type value) const
+            -> void
+        { m_elems->write(idx, value); }
+
+        auto read_block(size_type idx, std::span<element_type> out) const
+            -> void
+        { m_elems->read_block(idx, out); }
+
+        auto write_block(size_type idx, std::span<const element_type> in) const
+            -> void
+        { m_elems->write_block(idx, in); }
+
+        template<std::copy_constructible F = std::ranges::less>
+            requires std::invocable<F&, element_type, element_type>
+        auto compare(size_type x, size_type y, F cmp = {}) const
+            -> bool
+        { return m_elems->compare(x, y, cmp); }
+
+        auto swap_elems(size_type x, size_type y) const
+            -> void
+        { m_elems->swap_elems(x, y); }
+
+        auto count_comparisons(size_type n = 1uL) const
+            -> void
+        { m_elems->count_comparisons(n); }
+
+        auto mark(size_type idx, sf::Color colour) const noexcept
+            -> void
+        { m_viewer->mark(idx, colour); }
+
+        auto unmark(size_type idx) const noexcept
+            -> void
+        { m_viewer->unmark(idx); }
+
+        auto mark_range(size_type fidx, size_type eidx, sf::Color colour) const noexcept
+            -> void
+        { m_viewer->mark_range(fidx, eidx, colour); }
+
+        auto unmark_range(size_type fidx, size_type eidx) const noexcept
+            -> void
+        { m_viewer->unmark_range(fidx, eidx); }
+
+        /// `count` elements of auxiliary space, drawn on the auxiliary lane.
+        auto lease(size_type count) const
+            -> lease_type
+        { return lease_type{ m_elems->scratch().lease<element_type>(count, true), *m_elems, *m_viewer }; }
+
+        auto scratch() const noexcept
+            -> Scratch&
+        { return m_elems->scratch(); }
+
+    private:
+        Elements*   m_elems;
+        Viewer*     m_viewer;
+
+    };  /// class InstrumentedAccess
+
+    /// Raw access to a contiguous range. Counting, marking and pacing
+    /// compile away, leaving the algorithm's own loads and stores.
+    template<typename T>
+    class NativeAccess
+    {
+    public:
+
+        using element_type  = T;
+        using size_type     = std::size_t;
+        using lease_type    = Scratch::Lease<T>;
+
+    public:
+
+        explicit NativeAccess(std::span<T> items, Scratch& scratch = native_scratch()) noexcept
+            : m_items{ items }
+            , m_scratch{ &scratch }
+        { }
+
+        auto size() const noexcept
+            -> size_type
+        { return m_items.size(); }
+
+        auto read(size_type idx) const noexcept
+            -> element_type
+        { return m_items[idx]; }
+
+        auto silent_read(size_type idx) const noexcept
+            -> element_type
+        { return m_items[idx]; }
+
+        auto write(size_type idx, element_type value) const noexcept
+            -> void
+        { m_items[idx] = value; }
+
+        auto read_block(size_type idx, std::span<element_type> out) const noexcept
+            -> void
+        { std::ranges::copy(m_items.subspan(idx, out.size()), out.begin()); }
+
+        auto write_block(size_type idx, std::span<const element_type> in) const noexcept
+            -> void
+        { std::ranges::copy(in, m_items.begin() + static_cast<std::ptrdiff_t>(idx)); }
+
+        template<std::copy_constructible F = std::ranges::less>
+            requires std::invocable<F&, element_type, element_type>
+        auto compare(size_type x, size_type y, F cmp = {}) const
+            -> bool
+        { return cmp(m_items[x], m_items[y]); }
+
+        auto swap_elems(size_type x, size_type y) const noexcept
+            -> void
+        { std::swap(m_items[x], m_items[y]); }
+
+        auto count_comparisons([[maybe_unused]] size_type n = 1uL) const noexcept
+            -> void
+        { }
+
+        auto mark([[maybe_unused]] size_type idx, [[maybe_unused]] sf::Color colour) const noexcept
+            -> void
+        { }
+
+        auto unmark([[maybe_unused]] size_type idx) const noexcept
+            -> void
+        { }
+
+        auto mark_range([[maybe_unused]] size_type fidx, [[maybe_unused]] size_type eidx, [[maybe_unused]] sf::Color colour) const noexcept
+            -> void
+        { }
+
+        auto unmark_range([[maybe_unused]] size_type fidx, [[maybe_unused]] size_type eidx) const noexcept
+            -> void
+        { }
+
+        auto lease(size_type count) const
+            -> lease_type
+        { return m_scratch->template lease<T>(count); }
+
+        auto scratch() const noexcept
+            -> Scratch&
+        { return *m_scratch; }
+
+        /// The range being sorted, for baselines that sort it directly.
+        auto items() const noexcept
+            -> std::span<T>
+        { return m_items; }
+
+    private:
+        std::span<T>    m_items;
+        Scratch*        m_scratch;
+
+    };  /// class NativeAccess
+
+    /// Raw access to records stored as a structure of arrays: keys in one
+    /// range, payloads in another. Algorithms still see `Record<K, P>`;
+    /// reads gather one, writes scatter it and comparisons only load keys.
+    template<sort_key K, typename P>
+    class SoaAccess
+    {
+    public:
+
+        using element_type  = Record<K, P>;
+        using size_type     = std::size_t;
+        using lease_type    = Scratch::Lease<element_type>;
+
+    public:
+
+        explicit SoaAccess(std::span<K> keys, std::span<P> payloads, Scratch& scratch = native_scratch()) noexcept
+            : m_keys{ keys }
+            , m_payloads{ payloads }
+            , m_scratch{ &scratch }
+        { }
+
+        auto size() const noexcept
+            -> size_type
+        { return m_keys.size(); }
+
+        auto read(size_type idx) const noexcept
+            -> element_type
+        { return element_type{ m_keys[idx], m_payloads[idx] }; }
+
+        auto silent_read(size_type idx) const noexcept
+            -> element_type
+        { return read(idx); }
+
+        auto write(size_type idx, element_type value) const noexcept
+            -> void
+        {
+            m_keys[idx]     = value.key;
+            m_payloads[idx] = value.payload;
+        }
+
+        auto read_block(size_type idx, std::span<element_type> out) const noexcept
+            -> void
+        {
+            for (auto i { 0uL }; i < out.size(); ++i)
+                out[i] = read(idx + i);
+        }
+
+        auto write_block(size_type idx, std::span<const element_type> in) const noexcept
+            -> void
+        {
+            for (auto i { 0uL }; i < in.size(); ++i)
+                write(idx + i, in[i]);
+        }
+
+        template<std::copy_constructible F = std::ranges::less>
+            requires std::invocable<F&, element_type, element_type>
+        auto compare(size_type x, size_type y, F cmp = {}) const
+            -> bool
+        { return cmp(element_type{ m_keys[x], P{} }, element_type{ m_keys[y], P{} }); }
+
+        auto swap_elems(size_type x, size_type y) const noexcept
+            -> void
+        {
+            std::swap(m_keys[x], m_keys[y]);
+            std::swap(m_payloads[x], m_payloads[y]);
+        }
+
+        auto count_comparisons([[maybe_unused]] size_type n = 1uL) const noexcept
+            -> void
+        { }
+
+        auto mark([[maybe_unused]] size_type idx, [[maybe_unused]] sf::Color colour) const noexcept
+            -> void
+        { }
+
+        auto unmark([[maybe_unused]] size_type idx) const noexcept
+            -> void
+        { }
+
+        auto mark_range([[maybe_unused]] size_type fidx, [[maybe_unused]] size_type eidx, [[maybe_unused]] sf::Color colour) const noexcept
+            -> void
+        { }
+
+        auto unmark_range([[maybe_unused]] size_type fidx, [[maybe_unused]] size_type eidx) const noexcept
+            -> void
+        { }
+
+        auto lease(size_type count) const
+            -> lease_type
+        { return m_scratch->template lease<element_type>(count); }
+
+        auto scratch() const noexcept
+            -> Scratch&
+        { return *m_scratch; }
+
+    private:
+        std::span<K>    m_keys;
+        std::span<P>    m_payloads;
+        Scratch*        m_scratch;
+
+    };  /// class SoaAccess
+
+    /// Adapts an algorithm instantiated over `InstrumentedAccess` to the
+    /// `Sorter` registry's signature.
+    template<void (*Sort)(InstrumentedAccess&)>
+    auto instrumented(std::shared_ptr<Elements> elems, std::shared_ptr<Viewer> viewer)
+        -> void
+    {
+        auto access = InstrumentedAccess{ *elems, *viewer };
+        Sort(access);
+    }
+
+}  /// namespace sv
+
+#endif  // SV_ACCESS
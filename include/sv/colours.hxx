@@ -0,0 +1,95 @@
+#ifndef SV_COLOURS
+#   define SV_COLOURS
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sv
+{
+    /// One mark colour per element, set from the sorting threads while
+    /// the render thread reads them. Each colour is packed into a single
+    /// relaxed atomic, so a reader may see a mark a frame late but never
+    /// half of one.
+    class Colours
+    {
+    public:
+
+        using size_type     = std::size_t;
+        using colour_type   = sf::Color;
+        using slot_type     = std::atomic<std::uint32_t>;
+
+    public:
+
+        Colours() noexcept = default;
+
+        explicit Colours(size_type size, colour_type colour = colour_type::White)
+            : m_slots{ std::vector<slot_type>(size) }
+        { fill(0uL, size, colour); }
+
+        Colours(Colours&&) noexcept = default;
+        auto operator= (Colours&&) noexcept -> Colours& = default;
+
+        auto size() const noexcept
+            -> size_type
+        { return m_slots.size(); }
+
+        auto load(size_type idx) const noexcept
+            -> colour_type
+        { return _S_unpack(m_slots[idx].load(std::memory_order_relaxed)); }
+
+        auto store(size_type idx, colour_type colour) noexcept
+            -> void
+        { m_slots[idx].store(_S_pack(colour), std::memory_order_relaxed); }
+
+        /// Sets `[fidx, eidx)`, clipped to the size.
+        auto fill(size_type fidx, size_type eidx, colour_type colour) noexcept
+            -> void
+        {
+            auto packed { _S_pack(colour) };
+
+            for (auto i { fidx }; i < std::min(eidx, m_slots.size()); ++i)
+                m_slots[i].store(packed, std::memory_order_relaxed);
+        }
+
+        /// Not safe against concurrent readers; only call between sorts.
+        auto assign(size_type size, colour_type colour)
+            -> void
+        {
+            m_slots = std::vector<slot_type>(size);
+            fill(0uL, size, colour);
+        }
+
+        auto clear() noexcept
+            -> void
+        { m_slots.clear(); }
+
+    private:
+
+        static auto _S_pack(colour_type c) noexcept
+            -> std::uint32_t
+        { return std::uint32_t{ c.r } << 24 | std::uint32_t{ c.g } << 16 | std::uint32_t{ c.b } << 8 | std::uint32_t{ c.a }; }
+
+        static auto _S_unpack(std::uint32_t packed) noexcept
+            -> colour_type
+        {
+            return colour_type(
+                static_cast<std::uint8_t>(packed >> 24),
+                static_cast<std::uint8_t>(packed >> 16),
+                static_cast<std::uint8_t>(packed >> 8),
+                static_cast<std::uint8_t>(packed)
+            );
+        }
+
+    private:
+        std::vector<slot_type>  m_slots;
+
+    };  /// class Colours
+
+}  /// namespace sv
+
+#endif  // SV_COLOURS
@@ -0,0 +1,136 @@
+#ifndef SV_CONTROL
+#   define SV_CONTROL
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <stop_token>
+
+namespace sv
+{
+    /// Thrown out of the element access layer once the sorter has been
+    /// asked to stop. Unwinds the running algorithm back to `Sorter::sort`.
+    class sort_cancelled : public std::exception
+    {
+    public:
+        auto what() const noexcept
+            -> const char* override
+        { return "Sort cancelled"; }
+
+    };  /// class sort_cancelled
+
+    /// Cancellation, pause and single-stepping for the sorting thread.
+    /// `checkpoint` is called before every element access so a stop or
+    /// pause takes effect within one operation.
+    class Control
+    {
+    public:
+
+        using size_type     = std::size_t;
+        using clock_type    = std::chrono::steady_clock;
+        using duration_type = std::chrono::nanoseconds;
+
+    public:
+
+        Control() noexcept = default;
+
+        Control(const Control&) = delete;
+        auto operator= (const Control&) -> Control& = delete;
+
+        /// Binds the stop token of the thread about to run a sort.
+        auto bind(std::stop_token token) noexcept
+            -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            m_token = std::move(token);
+            m_held.store(duration_type::rep{}, std::memory_order_relaxed);
+        }
+
+        auto checkpoint()
+            -> void
+        {
+            if (m_token.stop_requested())
+                throw sort_cancelled{};
+
+            if (!m_paused.load(std::memory_order_acquire))
+                return;
+
+            auto start  { clock_type::now() };
+            auto lock   = std::unique_lock{ m_mutex };
+            m_cv.wait(lock, m_token, [this]
+            { return !m_paused.load(std::memory_order_acquire) || m_steps != size_type{}; });
+            m_held.fetch_add(std::chrono::duration_cast<duration_type>(clock_type::now() - start).count(), std::memory_order_relaxed);
+
+            if (m_token.stop_requested())
+                throw sort_cancelled{};
+
+            if (m_paused.load(std::memory_order_acquire))
+                m_steps -= 1uL;
+        }
+
+        /// Time the sorting thread has spent paused since the last `bind`.
+        auto held() const noexcept
+            -> duration_type
+        { return duration_type{ m_held.load(std::memory_order_relaxed) }; }
+
+        auto paused() const noexcept
+            -> bool
+        { return m_paused.load(std::memory_order_acquire); }
+
+        auto pause() noexcept
+            -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            m_paused.store(true, std::memory_order_release);
+            m_steps = size_type{};
+        }
+
+        auto resume() noexcept
+            -> void
+        {
+            {
+                auto lock = std::scoped_lock{ m_mutex };
+                m_paused.store(false, std::memory_order_release);
+                m_steps = size_type{};
+            }
+
+            m_cv.notify_all();
+        }
+
+        auto toggle_pause() noexcept
+            -> void
+        {
+            if (paused())
+                resume();
+            else
+                pause();
+        }
+
+        /// Lets `n` more operations through while paused.
+        auto step(size_type n) noexcept
+            -> void
+        {
+            {
+                auto lock = std::scoped_lock{ m_mutex };
+                m_steps += n;
+            }
+
+            m_cv.notify_all();
+        }
+
+    private:
+        std::mutex                      m_mutex;
+        std::condition_variable_any     m_cv;
+        std::stop_token                 m_token     { };
+        std::atomic<bool>               m_paused    { false };
+        size_type                       m_steps     { size_type{} };
+        std::atomic<duration_type::rep> m_held      { duration_type::rep{} };
+
+    };  /// class Control
+
+}  /// namespace sv
+
+#endif  // SV_CONTROL
@@ -0,0 +1,95 @@
+#ifndef SV_COUNTERS
+#   define SV_COUNTERS
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace sv
+{
+    /// Operation counters sharded per thread. Each thread bumps its own
+    /// cache line so parallel algorithms count exactly without bouncing
+    /// a shared line between cores; reads merge every shard.
+    class Counters
+    {
+    public:
+
+        using size_type     = std::size_t;
+        using value_type    = std::array<size_type, 4>;
+
+        enum Counter : size_type
+        {
+            COMPARISONS,
+            READS,
+            WRITES,
+            SWAPS
+        };
+
+    public:
+
+        Counters() noexcept = default;
+
+        Counters(const Counters&) = delete;
+        auto operator= (const Counters&) -> Counters& = delete;
+
+        auto add(Counter counter, size_type n = 1uL) noexcept
+            -> void
+        { m_shards[_S_slot()].values[counter].fetch_add(n, std::memory_order_relaxed); }
+
+        auto load() const noexcept
+            -> value_type
+        {
+            auto totals = value_type{};
+
+            for (const auto& shard : m_shards)
+                for (auto c { 0uL }; c < totals.size(); ++c)
+                    totals[c] += shard.values[c].load(std::memory_order_relaxed);
+
+            return totals;
+        }
+
+        /// Replaces the totals, eg. when restoring them from a trace.
+        auto store(const value_type& totals) noexcept
+            -> void
+        {
+            reset();
+
+            for (auto c { 0uL }; c < totals.size(); ++c)
+                m_shards.front().values[c].store(totals[c], std::memory_order_relaxed);
+        }
+
+        auto reset() noexcept
+            -> void
+        {
+            for (auto& shard : m_shards)
+                for (auto& value : shard.values)
+                    value.store(size_type{}, std::memory_order_relaxed);
+        }
+
+    private:
+
+        static constexpr auto s_shards { 64uL };
+
+        struct alignas(64) Shard
+        {
+            std::array<std::atomic<size_type>, 4> values {};
+        };
+
+        /// Threads are handed shards in the order they first count
+        /// anything. Past `s_shards` threads share, which stays exact.
+        static auto _S_slot() noexcept
+            -> size_type
+        {
+            static auto next = std::atomic<size_type>{ 0uL };
+            thread_local auto slot { next.fetch_add(1uL, std::memory_order_relaxed) % s_shards };
+            return slot;
+        }
+
+    private:
+        std::array<Shard, s_shards>     m_shards {};
+
+    };  /// class Counters
+
+}  /// namespace sv
+
+#endif  // SV_COUNTERS
@@ -0,0 +1,110 @@
+#ifndef SV_DIRTY
+#   define SV_DIRTY
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sv
+{
+    /// One flag per rendered bar, set from the sorting thread whenever
+    /// an element or mark under that bar changes and cleared by the
+    /// render thread once the bar has been rebuilt. Bars map onto
+    /// contiguous, evenly sized element ranges.
+    class DirtyBars
+    {
+    public:
+
+        using size_type     = std::size_t;
+        using flag_type     = std::atomic<std::uint8_t>;
+
+    public:
+
+        explicit DirtyBars(size_type elements, size_type bars)
+            : m_elements{ elements }
+            , m_bars{ bars }
+            , m_flags{ std::vector<flag_type>(bars) }
+        { touch_all(); }
+
+        auto elements() const noexcept
+            -> size_type
+        { return m_elements; }
+
+        auto bars() const noexcept
+            -> size_type
+        { return m_bars; }
+
+        auto bar(size_type idx) const noexcept
+            -> size_type
+        { return (idx * m_bars) / m_elements; }
+
+        /// First element drawn by bar `b`; `first(b + 1)` is one past its
+        /// last element.
+        auto first(size_type b) const noexcept
+            -> size_type
+        { return (b * m_elements + m_bars - 1uL) / m_bars; }
+
+        auto touch(size_type idx) noexcept
+            -> void
+        {
+            if (idx < m_elements)
+                m_flags[bar(idx)].store(1u, std::memory_order_relaxed);
+        }
+
+        auto touch_range(size_type fidx, size_type eidx) noexcept
+            -> void
+        {
+            if (eidx > m_elements)
+                eidx = m_elements;
+
+            if (fidx >= eidx)
+                return;
+
+            for (auto b { bar(fidx) }, last { bar(eidx - 1uL) }; b <= last; ++b)
+                m_flags[b].store(1u, std::memory_order_relaxed);
+        }
+
+        auto touch_all() noexcept
+            -> void
+        {
+            for (auto& flag : m_flags)
+                flag.store(1u, std::memory_order_relaxed);
+        }
+
+        /// Clears the dirty flags and calls `f(first_bar, last_bar)` for
+        /// every run of consecutive dirty bars, `last_bar` exclusive.
+        template<typename F>
+        auto consume(F&& f)
+            -> void
+        {
+            auto b { 0uL };
+
+            while (b < m_bars)
+            {
+                if (m_flags[b].exchange(0u, std::memory_order_acquire) == 0u)
+                {
+                    b += 1uL;
+                    continue;
+                }
+
+                auto run { b };
+                b += 1uL;
+
+                while (b < m_bars && m_flags[b].exchange(0u, std::memory_order_acquire) != 0u)
+                    b += 1uL;
+
+                f(run, b);
+            }
+        }
+
+    private:
+        size_type                   m_elements;
+        size_type                   m_bars;
+        std::vector<flag_type>      m_flags;
+
+    };  /// class DirtyBars
+
+}  /// namespace sv
+
+#endif  // SV_DIRTY
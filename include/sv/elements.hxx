@@ -3,13 +3,23 @@
 
 #include <SFML/Graphics.hpp>
 
+#include <sv/control.hxx>
+#include <sv/counters.hxx>
+#include <sv/dirty.hxx>
+#include <sv/inputs.hxx>
+#include <sv/pacer.hxx>
+#include <sv/scratch.hxx>
 #include <sv/sound.hxx>
+#include <sv/trace.hxx>
 
+#include <atomic>
 #include <chrono>
 #include <concepts>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <span>
 #include <thread>
 #include <tuple>
 #include <vector>
@@ -23,8 +33,14 @@ namespace sv
 
         using element_type          = float;
         using size_type             = std::size_t;
-        using duration_type         = std::chrono::microseconds;
+        using pacer_type            = std::shared_ptr<sv::Pacer>;
         using sound_type            = std::shared_ptr<sv::Sound>;
+        using trace_type            = std::shared_ptr<sv::TraceWriter>;
+        using dirty_type            = std::shared_ptr<sv::DirtyBars>;
+        using control_type          = std::shared_ptr<sv::Control>;
+        using scratch_type          = std::shared_ptr<sv::Scratch>;
+        using lease_type            = Scratch::Lease<element_type>;
+        using counters_type         = std::tuple<size_type, size_type, size_type, size_type>;
 
     public:
 
@@ -34,48 +50,40 @@ namespace sv
             : m_max_value{ elems.m_max_value }
             , m_min_value{ elems.m_min_value }
             , m_sort_amount{ elems.m_sort_amount }
-            , m_cmp_counter{ elems.m_cmp_counter }
-            , m_read_counter{ elems.m_read_counter }
-            , m_write_counter{ elems.m_write_counter }
-            , m_swap_counter{ elems.m_swap_counter }
-            , m_read_delay{ elems.m_read_delay }
-            , m_write_delay{ elems.m_write_delay }
-            , m_accumulated_delay{ elems.m_accumulated_delay }
+            , m_counters{ }
             , m_items{ std::move(elems.m_items) }
+            , m_pacer{ std::move(elems.m_pacer) }
             , m_sfx{ std::move(elems.m_sfx) }
+            , m_trace{ std::move(elems.m_trace) }
+            , m_dirty{ std::move(elems.m_dirty) }
+            , m_control{ std::move(elems.m_control) }
+            , m_scratch{ std::move(elems.m_scratch) }
         {
             elems.m_max_value       = element_type{};
             elems.m_min_value       = element_type{};
             elems.m_sort_amount     = size_type{};
-            elems.m_cmp_counter     = size_type{};
-            elems.m_read_counter    = size_type{};
-            elems.m_write_counter   = size_type{};
-            elems.m_swap_counter    = size_type{};
-            elems.m_read_delay      = duration_type{};
-            elems.m_write_delay     = duration_type{};
-            elems.m_accumulated_delay     = duration_type{};
+            m_counters.store(elems.m_counters.load());
+            elems.m_counters.reset();
             elems.m_sfx             = sound_type{};
         }
 
         explicit Elements(
             element_type max_value,
             size_type sort_amount,
-            duration_type read_delay,
-            duration_type write_delay,
+            pacer_type pacer,
             sound_type sound
         )
             : m_max_value{ max_value }
             , m_min_value{ max_value * 0.06f }
             , m_sort_amount{ sort_amount }
-            , m_cmp_counter{ size_type{} }
-            , m_read_counter{ size_type{} }
-            , m_write_counter{ size_type{} }
-            , m_swap_counter{ size_type{} }
-            , m_read_delay{ read_delay }
-            , m_write_delay{ write_delay }
-            , m_accumulated_delay{ duration_type{} }
+            , m_counters{ }
             , m_items{ std::vector<element_type>(m_sort_amount, element_type{}) }
+            , m_pacer{ pacer }
             , m_sfx{ sound }
+            , m_trace{ nullptr }
+            , m_dirty{ nullptr }
+            , m_control{ nullptr }
+            , m_scratch{ std::make_shared<Scratch>(sort_amount) }
         { _M_generate(); }
 
         constexpr auto
@@ -88,9 +96,16 @@ namespace sv
         {
             m_sort_amount = new_size;
             m_items.resize(new_size);
+            m_scratch->resize_lane(new_size);
             _M_generate();
         }
 
+        auto generate(InputShape shape, std::uint64_t seed)
+            -> void
+        {
+            _M_generate();
+            shape_items(m_items, shape, seed);
+        }
 
         constexpr auto
         max_value() noexcept 
@@ -100,67 +115,154 @@ namespace sv
         auto reset_counters() 
             noexcept -> void
         {
-            m_cmp_counter   = size_type{};
-            m_read_counter  = size_type{};
-            m_write_counter = size_type{};
-            m_swap_counter  = size_type{};
+            m_counters.reset();
+
+            if (m_scratch)
+                m_scratch->reset_stats();
         }
 
         template<std::copy_constructible F = std::ranges::less>
             requires std::invocable<F&, size_type, size_type>
         auto compare(const size_type& x, const size_type& y, F cmp = {})
-            noexcept -> bool
+            -> bool
         {
-            m_cmp_counter += size_type{ 1 };
+            m_counters.add(Counters::COMPARISONS);
+
+            auto a { _M_read(x) };
+            auto b { _M_read(y) };
 
-            auto a { this->read(x) };
-            auto b { this->read(y) };
+            if (m_trace)
+                m_trace->compare(x, y);
 
             return cmp(a, b);
         }
 
         auto swap_elems(const size_type& x, const size_type& y)
-            noexcept -> void
+            -> void
         {
-            m_swap_counter += 1uL;
+            m_counters.add(Counters::SWAPS);
 
-            auto a = this->read(x);
-            this->write(x, this->read(y));
-            this->write(y, a);
+            auto a { _M_read(x) };
+            auto b { _M_read(y) };
+
+            if (!_M_write(x, b) || !_M_write(y, a))
+                return;
+
+            auto change = [&]
+            {
+                m_items.at(x) = b;
+                m_items.at(y) = a;
+            };
+
+            if (m_trace)
+                m_trace->swap(x, y, change);
+            else
+                change();
+
+            if (m_dirty)
+            {
+                m_dirty->touch(x);
+                m_dirty->touch(y);
+            }
         }
 
-        auto read(size_type idx) noexcept
+        auto read(size_type idx)
             -> element_type
         {
-            if (idx > m_sort_amount)
-            {
-                std::clog << "Out of bound value: `" << idx << "` selected!" << std::endl;
-                return 0.0f;
-            }
+            auto value { _M_read(idx) };
 
-            m_read_counter += 1uL;
-            // m_sfx->play(Sound::SFX_Option::READ, 0.5f + ((1 * m_items.at(idx)) / m_max_value));
-            m_accumulated_delay += m_read_delay;
-            std::this_thread::sleep_for(m_read_delay);
-            return m_items.at(idx);
+            if (m_trace && idx <= m_sort_amount)
+                m_trace->read(idx);
+
+            return value;
         }
 
-        auto write(size_type idx, element_type value) noexcept
+        auto write(size_type idx, element_type value)
             -> void
         {
-            if (idx > m_sort_amount)
-            {
-                std::clog << "Out of bound value: `" 
-                          << idx 
-                          << "` selected! No write operation performed";
+            if (!_M_write(idx, value))
                 return;
-            }
 
-            m_write_counter += 1uL;
-            // m_sfx->play(Sound::SFX_Option::WRITE, 0.5f + ((0.45f * m_items.at(idx)) / m_max_value));
-            m_accumulated_delay += m_write_delay;
-            std::this_thread::sleep_for(m_write_delay);
-            m_items.at(idx) = value;
+            auto change = [&] { m_items.at(idx) = value; };
+
+            if (m_trace)
+                m_trace->write(idx, value, change);
+            else
+                change();
+
+            if (m_dirty)
+                m_dirty->touch(idx);
+        }
+
+        /// Reads `out.size()` consecutive elements from `idx` as one
+        /// block, paced as that many reads but landing all at once.
+        auto read_block(size_type idx, std::span<element_type> out)
+            -> void
+        {
+            if (!_M_block(idx, out.size()))
+                return;
+
+            m_counters.add(Counters::READS, out.size());
+            std::ranges::copy_n(m_items.begin() + static_cast<std::ptrdiff_t>(idx), static_cast<std::ptrdiff_t>(out.size()), out.begin());
+
+            if (m_sfx && !out.empty())
+                m_sfx->play(Sound::SFX_Option::READ, out.front() / m_max_value);
+
+            if (m_trace)
+                for (auto i { 0uL }; i < out.size(); ++i)
+                    m_trace->read(idx + i);
+        }
+
+        /// Writes `in` to the consecutive elements from `idx` as one block.
+        auto write_block(size_type idx, std::span<const element_type> in)
+            -> void
+        {
+            if (!_M_block(idx, in.size()))
+                return;
+
+            m_counters.add(Counters::WRITES, in.size());
+
+            if (m_sfx && !in.empty())
+                m_sfx->play(Sound::SFX_Option::WRITE, in.front() / m_max_value);
+
+            auto change = [&] { std::ranges::copy(in, m_items.begin() + static_cast<std::ptrdiff_t>(idx)); };
+
+            if (m_trace)
+                m_trace->write_block(idx, in, change);
+            else
+                change();
+
+            if (m_dirty)
+                m_dirty->touch_range(idx, idx + in.size());
+        }
+
+        /// Reads slot `idx` of an auxiliary lease, charged and paced like
+        /// a read of the elements.
+        auto aux_read(const lease_type& lease, size_type idx)
+            -> element_type
+        {
+            _M_aux();
+            m_counters.add(Counters::READS);
+
+            if (m_trace)
+                m_trace->aux_read();
+
+            return lease[idx];
+        }
+
+        /// Writes slot `idx` of an auxiliary lease and shows it on the
+        /// auxiliary lane.
+        auto aux_write(const lease_type& lease, size_type idx, element_type value)
+            -> void
+        {
+            _M_aux();
+            m_counters.add(Counters::WRITES);
+            lease[idx] = value;
+
+            if (m_trace)
+                m_trace->aux_write();
+
+            m_scratch->mirror(lease, idx, value);
         }
 
         auto silent_read(size_type idx) 
@@ -172,29 +274,135 @@ namespace sv
             -> std::vector<element_type>&
         { return m_items; }
 
-        auto counters() noexcept
-            -> decltype(auto)
+        /// Comparisons, reads, writes and swaps, merged across threads.
+        auto counters() const noexcept
+            -> counters_type
         { 
-            return std::forward_as_tuple(
-                m_cmp_counter,
-                m_read_counter,
-                m_write_counter,
-                m_swap_counter
-            );
+            auto [c, r, w, s] = m_counters.load();
+            return counters_type{ c, r, w, s };
         }
 
-        auto delays() noexcept
-            -> decltype(auto)
-        { 
-            return std::forward_as_tuple(
-                m_read_delay,
-                m_write_delay,
-                m_accumulated_delay
-            );
+        auto set_counters(size_type cmps, size_type reads, size_type writes, size_type swaps) noexcept
+            -> void
+        { m_counters.store(Counters::value_type{ cmps, reads, writes, swaps }); }
+
+        /// For comparisons made on values already read, eg. from a
+        /// scratch buffer.
+        auto count_comparisons(size_type n = 1uL)
+            -> void
+        {
+            m_counters.add(Counters::COMPARISONS, n);
+
+            if (m_trace)
+                m_trace->comparisons(n);
         }
 
+        auto pacer() noexcept
+            -> pacer_type&
+        { return m_pacer; }
+
+        auto scratch() noexcept
+            -> Scratch&
+        { return *m_scratch; }
+
+        /// Records every subsequent operation into `trace`. Pass
+        /// `nullptr` to stop recording.
+        auto trace(trace_type trace) noexcept
+            -> void
+        { m_trace = std::move(trace); }
+
+        /// Flags the bar drawing each written element so the viewer
+        /// only rebuilds what changed.
+        auto watch(dirty_type dirty) noexcept
+            -> void
+        { m_dirty = std::move(dirty); }
+
+        /// Every access goes through `control` first, which is where
+        /// cancellation and pausing of the sorting thread happen.
+        auto control(control_type control) noexcept
+            -> void
+        { m_control = std::move(control); }
+
     private:
 
+        auto _M_read(size_type idx)
+            -> element_type
+        {
+            if (m_control)
+                m_control->checkpoint();
+
+            if (idx > m_sort_amount)
+            {
+                std::clog << "Out of bound value: `" << idx << "` selected!" << std::endl;
+                return 0.0f;
+            }
+
+            m_counters.add(Counters::READS);
+
+            if (m_sfx)
+                m_sfx->play(Sound::SFX_Option::READ, m_items.at(idx) / m_max_value);
+
+            if (m_pacer)
+                m_pacer->pace();
+
+            return m_items.at(idx);
+        }
+
+        /// Checks, counts and paces a write. The caller stores it, under
+        /// the trace's lock while recording.
+        auto _M_write(size_type idx, element_type value)
+            -> bool
+        {
+            if (m_control)
+                m_control->checkpoint();
+
+            if (idx > m_sort_amount)
+            {
+                std::clog << "Out of bound value: `" 
+                          << idx 
+                          << "` selected! No write operation performed";
+                return false;
+            }
+
+            m_counters.add(Counters::WRITES);
+
+            if (m_sfx)
+                m_sfx->play(Sound::SFX_Option::WRITE, value / m_max_value);
+
+            if (m_pacer)
+                m_pacer->pace();
+
+            return true;
+        }
+
+        auto _M_aux()
+            -> void
+        {
+            if (m_control)
+                m_control->checkpoint();
+
+            if (m_pacer)
+                m_pacer->pace();
+        }
+
+        auto _M_block(size_type idx, size_type n)
+            -> bool
+        {
+            if (m_control)
+                m_control->checkpoint();
+
+            if (idx + n > m_sort_amount)
+            {
+                std::clog << "Out of bound block: `" << idx << "` + " << n << " selected!" << std::endl;
+                return false;
+            }
+
+            if (m_pacer && n)
+                m_pacer->pace(n);
+
+            return true;
+        }
+
         auto _M_generate()
             noexcept -> void
         {
@@ -215,18 +423,16 @@ namespace sv
         element_type                m_min_value;
         size_type                   m_sort_amount;
 
-        size_type                   m_cmp_counter;
-        size_type                   m_read_counter;
-        size_type                   m_write_counter;
-        size_type                   m_swap_counter;
-
-        duration_type               m_read_delay;
-        duration_type               m_write_delay;
-        duration_type               m_accumulated_delay;
+        Counters                    m_counters;
 
         std::vector<element_type>   m_items;
 
+        pacer_type                  m_pacer;
         sound_type                  m_sfx;
+        trace_type                  m_trace;
+        dirty_type                  m_dirty;
+        control_type                m_control;
+        scratch_type                m_scratch;
         
     };  /// class Elements
 
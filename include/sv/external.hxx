@@ -0,0 +1,356 @@
+#ifndef SV_EXTERNAL
+#   define SV_EXTERNAL
+
+#include <sys/mman.h>
+
+#include <sv/access.hxx>
+#include <sv/keys.hxx>
+#include <sv/loser_tree.hxx>
+#include <sv/mapped_file.hxx>
+#include <sv/scratch.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace std::literals;
+
+namespace sv
+{
+    /// What an external sort moved and where its time went. I/O time is
+    /// spent copying to and from the mappings, which is where pages are
+    /// faulted in and dirtied; CPU time is the rest. `memory` is the most
+    /// scratch either phase held.
+    struct ExternalStats
+    {
+        using size_type     = std::size_t;
+        using duration_type = std::chrono::nanoseconds;
+
+        struct Phase
+        {
+            duration_type   io      { };
+            duration_type   cpu     { };
+        };
+
+        size_type   keys            { 0uL };
+        size_type   runs            { 0uL };
+        size_type   run_length      { 0uL };
+        size_type   passes          { 0uL };
+        size_type   fan_in          { 0uL };
+        size_type   bytes_read      { 0uL };
+        size_type   bytes_written   { 0uL };
+        size_type   memory          { 0uL };
+        Phase       formation       { };
+        Phase       merge           { };
+    };
+
+    /// Sorts a file of raw `T` keys into another without holding more
+    /// than `budget` bytes of it in memory. Runs of half the budget, less
+    /// a block for the in-memory sort's tables (the other half is its
+    /// scratch), are sorted with one of the registered algorithms and
+    /// written to a temporary file next to the output, then merged by a
+    /// loser tree that streams every run through its own buffer. Buffers are never smaller than
+    /// `s_min_block`, so when there are more runs than the budget has
+    /// buffers for, groups of them are merged into longer runs first, in
+    /// as many passes as it takes. Every transfer is a large sequential
+    /// copy, and the next block of each run is requested from the kernel
+    /// before it is needed.
+    template<sort_key T>
+    class ExternalSort
+    {
+    public:
+
+        using size_type     = std::size_t;
+        using clock_type    = std::chrono::steady_clock;
+        using sort_type     = void (*)(NativeAccess<T>&);
+
+    public:
+
+        explicit ExternalSort(size_type budget, sort_type sort) noexcept
+            : m_budget{ std::max(budget, s_min_budget) }
+            , m_sort{ sort }
+            , m_stats{ }
+        { }
+
+        auto sort(const fs::path& input, const fs::path& output)
+            -> ExternalStats
+        {
+            auto in = MappedFile{ input };
+
+            if (in.size() % sizeof(T) != 0uL)
+                throw std::runtime_error{ "`"s + input.string() + "` is not a whole number of keys."s };
+
+            m_stats = ExternalStats{};
+            m_stats.keys = in.size() / sizeof(T);
+
+            if (m_stats.keys == 0uL)
+            {
+                MappedFile::create(output, 0uL);
+                return m_stats;
+            }
+
+            auto temporary  = Temporary{ fs::path{ output } += ".runs"s };
+            auto spare      = Temporary{ fs::path{ output } += ".merge"s };
+
+            auto runs = MappedFile::create(temporary.path, in.size());
+            _M_form_runs(in, runs);
+
+            in = MappedFile{};
+            auto out = MappedFile::create(output, runs.size());
+            _M_merge(runs, out, spare.path);
+
+            return m_stats;
+        }
+
+        auto stats() const noexcept
+            -> const ExternalStats&
+        { return m_stats; }
+
+    private:
+
+        static constexpr auto s_min_budget { size_type{ 1uL << 20uL } };
+        static constexpr auto s_min_block  { size_type{ 64uL * 1024uL } };
+
+        /// A file next to the output, removed however the sort ends.
+        /// Declared before the mappings of it, so they are closed first.
+        struct Temporary
+        {
+            fs::path    path;
+
+            explicit Temporary(fs::path p) noexcept
+                : path{ std::move(p) }
+            { }
+
+            Temporary(const Temporary&) = delete;
+            auto operator= (const Temporary&) -> Temporary& = delete;
+
+            ~Temporary() noexcept
+            {
+                auto error = std::error_code{};
+                fs::remove(path, error);
+            }
+        };
+
+        /// Copies `bytes` between a mapping and memory, charged as I/O.
+        auto _M_copy(void* to, const void* from, size_type bytes, ExternalStats::Phase& phase)
+            -> void
+        {
+            auto start { clock_type::now() };
+            std::memcpy(to, from, bytes);
+            phase.io += clock_type::now() - start;
+        }
+
+        auto _M_form_runs(const MappedFile& in, MappedFile& runs)
+            -> void
+        {
+            auto start  { clock_type::now() };
+            auto N      { m_stats.keys };
+            auto length { std::max((m_budget - s_min_block) / 2uL / sizeof(T), 1uL) };
+            auto scratch = Scratch{};
+            auto memory = scratch.template lease<T>(std::min(length, N));
+
+            m_stats.run_length = length;
+            m_stats.runs = (N + length - 1uL) / length;
+
+            in.advise(0uL, in.size(), MADV_SEQUENTIAL);
+
+            for (auto first { 0uL }; first < N; first += length)
+            {
+                auto n      { std::min(length, N - first) };
+                auto offset { first * sizeof(T) };
+                auto bytes  { n * sizeof(T) };
+
+                /// Let the kernel read the next run while this one sorts.
+                in.advise(offset + bytes, bytes, MADV_WILLNEED);
+
+                _M_copy(memory.data(), in.data() + offset, bytes, m_stats.formation);
+                in.advise(offset, bytes, MADV_DONTNEED);
+                m_stats.bytes_read += bytes;
+
+                auto access = NativeAccess<T>{ std::span{ memory.data(), n }, scratch };
+                m_sort(access);
+
+                _M_copy(runs.data() + offset, memory.data(), bytes, m_stats.formation);
+                runs.flush(offset, bytes);
+                runs.advise(offset, bytes, MADV_DONTNEED);
+                m_stats.bytes_written += bytes;
+            }
+
+            m_stats.memory = std::max(m_stats.memory, scratch.stats().reserved);
+            m_stats.formation.cpu = clock_type::now() - start - m_stats.formation.io;
+        }
+
+        /// How many runs one merge can take: each needs a buffer of at
+        /// least `s_min_block` and four counters, and so does the output,
+        /// and the counter table is leased as one block of its own.
+        auto _M_fan_in() const noexcept
+            -> size_type
+        {
+            auto per_run { s_min_block + 4uL * sizeof(size_type) };
+            return std::max((m_budget - s_min_block) / per_run, 3uL) - 1uL;
+        }
+
+        /// Merges runs in groups of at most the fan-in until one is left.
+        /// Passes alternate between `runs` and a spare file, and the last
+        /// one writes to `out`.
+        auto _M_merge(MappedFile& runs, MappedFile& out, const fs::path& spare_path)
+            -> void
+        {
+            using run_type = std::pair<size_type, size_type>;
+
+            auto start  { clock_type::now() };
+            auto N      { m_stats.keys };
+            auto length { m_stats.run_length };
+            auto fan_in { _M_fan_in() };
+
+            auto bounds = std::vector<run_type>{};
+
+            for (auto first { 0uL }; first < N; first += length)
+                bounds.emplace_back(first, std::min(first + length, N));
+
+            auto passes { 1uL };
+
+            for (auto k { bounds.size() }; k > fan_in; k = (k + fan_in - 1uL) / fan_in)
+                passes += 1uL;
+
+            m_stats.fan_in = fan_in;
+            m_stats.passes = passes;
+
+            auto spare = passes > 1uL ? MappedFile::create(spare_path, runs.size()) : MappedFile{};
+            auto* from = &runs;
+
+            for (auto pass { 1uL }; pass <= passes; ++pass)
+            {
+                auto* to    = pass == passes ? &out : from == &runs ? &spare : &runs;
+                auto fan    { std::min(fan_in, bounds.size()) };
+                auto merged = std::vector<run_type>{};
+                auto scratch = Scratch{};
+
+                /// Every group of the pass shares the same buffers.
+                auto table   = scratch.template lease<size_type>(4uL * fan);
+                auto room    { m_budget - std::min(m_budget, scratch.stats().reserved) };
+                auto block   { std::max(room / (fan + 1uL) / sizeof(T), s_min_block / sizeof(T)) };
+                auto buffers = scratch.template lease<T>((fan + 1uL) * block);
+
+                for (auto g { 0uL }; g < bounds.size(); g += fan)
+                {
+                    auto group = std::span{ bounds }.subspan(g, std::min(fan, bounds.size() - g));
+                    _M_merge_group(*from, *to, group, { table.data(), table.size() }, { buffers.data(), buffers.size() }, block);
+                    merged.emplace_back(group.front().first, group.back().second);
+                }
+
+                m_stats.memory = std::max(m_stats.memory, scratch.stats().reserved);
+                bounds = std::move(merged);
+                from = to;
+            }
+
+            m_stats.merge.cpu = clock_type::now() - start - m_stats.merge.io;
+        }
+
+        /// Merges the sorted, adjacent `runs` of `from` into the same
+        /// span of `to`, streaming each through a `block` of `buffers`
+        /// with its four counters in `table`. The output has the block
+        /// after the last run's.
+        auto _M_merge_group(
+            const MappedFile& from,
+            MappedFile& to,
+            std::span<const std::pair<size_type, size_type>> runs,
+            std::span<size_type> table,
+            std::span<T> buffers,
+            size_type block
+        ) -> void
+        {
+            auto k       { runs.size() };
+            auto fan     { table.size() / 4uL };
+            auto heads   { table.data() };
+            auto ends    { table.data() + fan };
+            auto cursors { table.data() + 2uL * fan };
+            auto fills   { table.data() + 3uL * fan };
+            auto output  { buffers.data() + k * block };
+            auto tree    = LoserTree<T>{ k };
+
+            auto refill = [&](size_type r)
+            {
+                auto n      { std::min(block, ends[r] - heads[r]) };
+                auto offset { heads[r] * sizeof(T) };
+
+                _M_copy(buffers.data() + r * block, from.data() + offset, n * sizeof(T), m_stats.merge);
+                from.advise(offset, n * sizeof(T), MADV_DONTNEED);
+                from.advise(offset + n * sizeof(T), block * sizeof(T), MADV_WILLNEED);
+
+                m_stats.bytes_read += n * sizeof(T);
+                heads[r]   += n;
+                fills[r]    = n;
+                cursors[r]  = 0uL;
+            };
+
+            auto flush = [&](size_type first, size_type n)
+            {
+                auto offset { first * sizeof(T) };
+
+                _M_copy(to.data() + offset, output, n * sizeof(T), m_stats.merge);
+                to.flush(offset, n * sizeof(T));
+                to.advise(offset, n * sizeof(T), MADV_DONTNEED);
+                m_stats.bytes_written += n * sizeof(T);
+            };
+
+            for (auto r { 0uL }; r < k; ++r)
+            {
+                heads[r] = runs[r].first;
+                ends[r]  = runs[r].second;
+                refill(r);
+                tree.set(r, buffers.data()[r * block]);
+            }
+
+            tree.build();
+
+            auto written { runs.front().first };
+            auto pending { 0uL };
+
+            while (!tree.empty())
+            {
+                auto r { tree.winner() };
+                output[pending++] = tree.top();
+
+                if (pending == block)
+                {
+                    flush(written, pending);
+                    written += std::exchange(pending, 0uL);
+                }
+
+                if (++cursors[r] == fills[r])
+                {
+                    if (heads[r] == ends[r])
+                    {
+                        tree.exhaust();
+                        continue;
+                    }
+
+                    refill(r);
+                }
+
+                tree.replace(buffers.data()[r * block + cursors[r]]);
+            }
+
+            flush(written, pending);
+        }
+
+    private:
+        size_type       m_budget;
+        sort_type       m_sort;
+        ExternalStats   m_stats;
+
+    };  /// class ExternalSort
+
+}  /// namespace sv
+
+#endif  // SV_EXTERNAL
@@ -0,0 +1,115 @@
+#ifndef SV_INPUTS
+#   define SV_INPUTS
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::literals;
+
+namespace sv
+{
+    /// Starting arrangements for the generated data. Every shape is
+    /// a permutation (or quantisation) of the sorted ramp so that
+    /// runs of the same size and seed always see identical values.
+    enum class InputShape : short
+    { RANDOM, SORTED, REVERSED, FEW_UNIQUE, SAWTOOTH };
+
+    inline constexpr auto input_shapes = std::array{
+        InputShape::RANDOM,
+        InputShape::SORTED,
+        InputShape::REVERSED,
+        InputShape::FEW_UNIQUE,
+        InputShape::SAWTOOTH
+    };
+
+    inline auto shape_name(InputShape shape) noexcept
+        -> std::string_view
+    {
+        switch (shape)
+        {
+            case InputShape::RANDOM:        return "random"sv;
+            case InputShape::SORTED:        return "sorted"sv;
+            case InputShape::REVERSED:      return "reversed"sv;
+            case InputShape::FEW_UNIQUE:    return "few-unique"sv;
+            case InputShape::SAWTOOTH:      return "sawtooth"sv;
+        }
+
+        return "unknown"sv;
+    }
+
+    inline auto parse_shape(std::string_view name) noexcept
+        -> std::optional<InputShape>
+    {
+        for (auto shape : input_shapes)
+            if (shape_name(shape) == name)
+                return shape;
+
+        return std::nullopt;
+    }
+
+    /// Rearranges an ascending ramp in `items` into `shape`. The
+    /// engine is seeded explicitly so inputs are reproducible.
+    template<typename T>
+    auto shape_items(std::vector<T>& items, InputShape shape, std::uint64_t seed)
+        -> void
+    {
+        constexpr auto unique_values { 8uL };
+        constexpr auto teeth { 8uL };
+
+        auto eng = std::mt19937_64{ seed };
+        auto N { items.size() };
+
+        std::ranges::sort(items);
+
+        switch (shape)
+        {
+            case InputShape::RANDOM:
+                std::ranges::shuffle(items, eng);
+                break;
+
+            case InputShape::SORTED:
+                break;
+
+            case InputShape::REVERSED:
+                std::ranges::reverse(items);
+                break;
+
+            case InputShape::FEW_UNIQUE:
+            {
+                /// Fewer elements than levels get one level each.
+                auto L { std::min(N, unique_values) };
+                auto levels = std::vector<T>(L, T{});
+                for (auto l { 0uL }; l < L; ++l)
+                    levels.at(l) = items.at(((l + 1uL) * N) / L - 1uL);
+
+                for (auto i { 0uL }; i < N; ++i)
+                    items.at(i) = levels.at((i * L) / N);
+
+                std::ranges::shuffle(items, eng);
+                break;
+            }
+
+            case InputShape::SAWTOOTH:
+            {
+                auto ramp = items;
+                auto k { 0uL };
+
+                for (auto t { 0uL }; t < teeth; ++t)
+                    for (auto i { t }; i < N; i += teeth)
+                        items.at(k++) = ramp.at(i);
+
+                break;
+            }
+        }
+    }
+
+}  /// namespace sv
+
+#endif  // SV_INPUTS
@@ -0,0 +1,108 @@
+#ifndef SV_KEYS
+#   define SV_KEYS
+
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+namespace sv
+{
+    /// Scalar keys the algorithms can sort and the radix sort can turn
+    /// into unsigned bits.
+    template<typename K>
+    concept sort_key = std::integral<K> || std::same_as<K, float> || std::same_as<K, double>;
+
+    /// A key with a payload carried along with it. Records are ordered
+    /// by key alone, so equal keys compare equal whatever their payload.
+    template<sort_key K, typename P>
+    struct Record
+    {
+        using key_type      = K;
+        using payload_type  = P;
+
+        K   key;
+        P   payload;
+
+        friend constexpr auto operator<=> (const Record& lhs, const Record& rhs) noexcept
+        { return lhs.key <=> rhs.key; }
+
+        friend constexpr auto operator== (const Record& lhs, const Record& rhs) noexcept
+            -> bool
+        { return lhs.key == rhs.key; }
+    };
+
+    template<typename T>
+    struct is_record : std::false_type { };
+
+    template<typename K, typename P>
+    struct is_record<Record<K, P>> : std::true_type { };
+
+    template<typename T>
+    inline constexpr auto is_record_v { is_record<T>::value };
+
+    /// The key an element is ordered by: itself, or a record's key.
+    template<typename T>
+    constexpr auto key_of(const T& value) noexcept
+        -> const auto&
+    {
+        if constexpr (is_record_v<T>)
+            return value.key;
+        else
+            return value;
+    }
+
+    template<typename T>
+    using key_type_t = std::remove_cvref_t<decltype(key_of(std::declval<const T&>()))>;
+
+    /// The unsigned integer as wide as the key of `T`.
+    template<typename T>
+    using radix_type_t = std::conditional_t<sizeof(key_type_t<T>) <= 4uL, std::uint32_t, std::uint64_t>;
+
+    /// Maps a key to unsigned bits that order the same way, so a radix
+    /// sort over the bits sorts the keys. Signed integers flip the sign
+    /// bit; floats also flip every other bit of a negative value.
+    template<typename T>
+    constexpr auto radix_bits(const T& value) noexcept
+        -> radix_type_t<T>
+    {
+        using key_type  = key_type_t<T>;
+        using bits_type = radix_type_t<T>;
+
+        constexpr auto sign { bits_type{ 1u } << (sizeof(key_type) * 8uL - 1uL) };
+        auto key { key_of(value) };
+
+        if constexpr (std::floating_point<key_type>)
+        {
+            auto bits { std::bit_cast<std::conditional_t<sizeof(key_type) == 4uL, std::uint32_t, std::uint64_t>>(key) };
+            return static_cast<bits_type>((bits & sign) ? ~bits : bits | sign);
+        }
+        else if constexpr (std::signed_integral<key_type>)
+            return static_cast<bits_type>(static_cast<std::make_unsigned_t<key_type>>(key) ^ sign);
+        else
+            return static_cast<bits_type>(key);
+    }
+
+    /// How far apart two keys are, for the algorithms that place
+    /// elements by value (bucket and counting sort). Only needs to be
+    /// monotonic, which the conversion to double keeps for wide keys.
+    template<typename T>
+    constexpr auto key_distance(const T& lhs, const T& rhs) noexcept
+        -> double
+    { return static_cast<double>(key_of(lhs)) - static_cast<double>(key_of(rhs)); }
+
+    /// Whether a key is a whole number, as counting sort needs it to be.
+    template<typename T>
+    auto whole_key(const T& value) noexcept
+        -> bool
+    {
+        if constexpr (std::floating_point<key_type_t<T>>)
+            return std::trunc(key_of(value)) == key_of(value);
+        else
+            return true;
+    }
+
+}  /// namespace sv
+
+#endif  // SV_KEYS
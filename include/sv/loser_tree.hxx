@@ -0,0 +1,135 @@
+#ifndef SV_LOSER_TREE
+#   define SV_LOSER_TREE
+
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace sv
+{
+    /// Tournament tree for a k-way merge. Every internal node keeps the
+    /// loser of the match played there, so replacing the winner replays
+    /// only the path from its leaf to the root: `levels()` comparisons
+    /// per element, against `2 * levels()` for a binary heap. Ties go to
+    /// the lower sequence, which keeps the merge stable.
+    template<typename T>
+    class LoserTree
+    {
+    public:
+
+        using value_type    = T;
+        using size_type     = std::size_t;
+
+    public:
+
+        /// Sequences start exhausted; give each one its head with `set`
+        /// and then call `build`.
+        explicit LoserTree(size_type k)
+            : m_keys(k, T{})
+            , m_live(k, false)
+            , m_tree(k, k)
+            , m_levels{ static_cast<size_type>(std::bit_width(k > 1uL ? k - 1uL : 0uL)) }
+        { }
+
+        auto set(size_type idx, T key)
+            -> void
+        {
+            m_keys[idx] = key;
+            m_live[idx] = true;
+        }
+
+        /// Plays every sequence's first match.
+        auto build()
+            -> void
+        {
+            m_tree.assign(m_tree.size(), m_keys.size());
+
+            for (auto i { 0uL }; i < m_keys.size(); ++i)
+                _M_play(i, true);
+        }
+
+        /// The sequence whose head is smallest.
+        auto winner() const noexcept
+            -> size_type
+        { return m_tree.front(); }
+
+        auto top() const noexcept
+            -> const T&
+        { return m_keys[winner()]; }
+
+        /// Whether every sequence is exhausted.
+        auto empty() const noexcept
+            -> bool
+        { return m_keys.empty() || !m_live[winner()]; }
+
+        /// Replaces the winner's head with the next element of its sequence.
+        auto replace(T key)
+            -> void
+        {
+            m_keys[winner()] = key;
+            _M_play(winner(), false);
+        }
+
+        /// Marks the winner's sequence as exhausted.
+        auto exhaust()
+            -> void
+        {
+            m_live[winner()] = false;
+            _M_play(winner(), false);
+        }
+
+        /// Matches played per replacement.
+        auto levels() const noexcept
+            -> size_type
+        { return m_levels; }
+
+    private:
+
+        auto _M_beats(size_type a, size_type b) const noexcept
+            -> bool
+        {
+            if (!m_live[b])
+                return true;
+
+            if (!m_live[a])
+                return false;
+
+            return m_keys[a] < m_keys[b] || (!(m_keys[b] < m_keys[a]) && a < b);
+        }
+
+        /// Walks leaf `idx` towards the root. While building, a node no
+        /// one has reached yet keeps the arrival and waits for the other
+        /// half of its subtree.
+        auto _M_play(size_type idx, bool building)
+            -> void
+        {
+            auto k      { m_keys.size() };
+            auto winner { idx };
+
+            for (auto node { (idx + k) / 2uL }; node > 0uL; node /= 2uL)
+            {
+                if (building && m_tree[node] == k)
+                {
+                    m_tree[node] = winner;
+                    return;
+                }
+
+                if (_M_beats(m_tree[node], winner))
+                    std::swap(m_tree[node], winner);
+            }
+
+            m_tree.front() = winner;
+        }
+
+    private:
+        std::vector<T>          m_keys;
+        std::vector<char>       m_live;
+        std::vector<size_type>  m_tree;
+        size_type               m_levels;
+
+    };  /// class LoserTree
+
+}  /// namespace sv
+
+#endif  // SV_LOSER_TREE
@@ -0,0 +1,188 @@
+#ifndef SV_MAPPED_FILE
+#   define SV_MAPPED_FILE
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace fs = std::filesystem;
+using namespace std::literals;
+
+namespace sv
+{
+    /// Memory mapping of a whole file, read-only unless made by `create`.
+    /// Pages are only faulted in as they are touched so files far larger
+    /// than RAM can be walked without being loaded.
+    class MappedFile
+    {
+    public:
+
+        using size_type     = std::size_t;
+        using byte_type     = std::uint8_t;
+
+    public:
+
+        MappedFile() noexcept = default;
+
+        explicit MappedFile(const fs::path& path)
+            : m_fd{ ::open(path.c_str(), O_RDONLY) }
+            , m_data{ nullptr }
+            , m_size{ size_type{} }
+        {
+            if (m_fd < 0)
+                throw std::runtime_error{ "Could not open `"s + path.string() + "`."s };
+
+            struct stat st {};
+            if (::fstat(m_fd, &st) != 0)
+            {
+                ::close(m_fd);
+                throw std::runtime_error{ "Could not stat `"s + path.string() + "`."s };
+            }
+
+            m_size = static_cast<size_type>(st.st_size);
+            _M_map(path, PROT_READ);
+        }
+
+        /// Creates (or truncates) `path` to `size` bytes and maps it for
+        /// writing. Written pages reach the file as the kernel writes
+        /// them back, or sooner with `flush`.
+        static auto create(const fs::path& path, size_type size)
+            -> MappedFile
+        {
+            auto file = MappedFile{};
+            file.m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+            if (file.m_fd < 0)
+                throw std::runtime_error{ "Could not create `"s + path.string() + "`."s };
+
+            if (::ftruncate(file.m_fd, static_cast<off_t>(size)) != 0)
+                throw std::runtime_error{ "Could not resize `"s + path.string() + "`."s };
+
+            file.m_size = size;
+            file._M_map(path, PROT_READ | PROT_WRITE);
+            return file;
+        }
+
+        MappedFile(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept
+            : m_fd{ std::exchange(other.m_fd, -1) }
+            , m_data{ std::exchange(other.m_data, nullptr) }
+            , m_size{ std::exchange(other.m_size, size_type{}) }
+        { }
+
+        auto operator= (const MappedFile&) -> MappedFile& = delete;
+
+        auto operator= (MappedFile&& other) noexcept
+            -> MappedFile&
+        {
+            if (this != &other)
+            {
+                _M_release();
+                m_fd    = std::exchange(other.m_fd, -1);
+                m_data  = std::exchange(other.m_data, nullptr);
+                m_size  = std::exchange(other.m_size, size_type{});
+            }
+
+            return *this;
+        }
+
+        ~MappedFile() noexcept
+        { _M_release(); }
+
+        auto data() const noexcept
+            -> const byte_type*
+        { return m_data; }
+
+        /// Only writable for mappings made by `create`.
+        auto data() noexcept
+            -> byte_type*
+        { return m_data; }
+
+        auto size() const noexcept
+            -> size_type
+        { return m_size; }
+
+        /// Hints the kernel about the upcoming access pattern for
+        /// `[offset, offset + length)`, eg. `MADV_SEQUENTIAL` or
+        /// `MADV_WILLNEED` to start read-ahead.
+        auto advise(size_type offset, size_type length, int advice) const noexcept
+            -> void
+        {
+            if (m_data == nullptr || offset >= m_size)
+                return;
+
+            auto first { offset - (offset % s_page) };
+            auto last  { std::min(offset + length, m_size) };
+
+            ::madvise(m_data + first, last - first, advice);
+        }
+
+        /// Starts writing `[offset, offset + length)` back to the file
+        /// without waiting for it.
+        auto flush(size_type offset, size_type length) const noexcept
+            -> void
+        {
+            if (m_data == nullptr || offset >= m_size)
+                return;
+
+            auto first { offset - (offset % s_page) };
+            auto last  { std::min(offset + length, m_size) };
+
+            ::msync(m_data + first, last - first, MS_ASYNC);
+        }
+
+    private:
+
+        static constexpr auto s_page { size_type{ 4096uL } };
+
+        auto _M_map(const fs::path& path, int protection)
+            -> void
+        {
+            if (m_size == size_type{})
+                return;
+
+            auto addr { ::mmap(nullptr, m_size, protection, MAP_SHARED, m_fd, 0) };
+
+            if (addr == MAP_FAILED)
+            {
+                _M_release();
+                throw std::runtime_error{ "Could not map `"s + path.string() + "`."s };
+            }
+
+            m_data = static_cast<byte_type*>(addr);
+        }
+
+        auto _M_release() noexcept
+            -> void
+        {
+            if (m_data != nullptr)
+                ::munmap(m_data, m_size);
+
+            if (m_fd >= 0)
+                ::close(m_fd);
+
+            m_data  = nullptr;
+            m_size  = size_type{};
+            m_fd    = -1;
+        }
+
+    private:
+        int                 m_fd        { -1 };
+        byte_type*          m_data      { nullptr };
+        size_type           m_size      { size_type{} };
+
+    };  /// class MappedFile
+
+}  /// namespace sv
+
+#endif  // SV_MAPPED_FILE
@@ -0,0 +1,276 @@
+#ifndef SV_PACER
+#   define SV_PACER
+
+#include <sv/control.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <stop_token>
+
+namespace sv
+{
+    /// Throttles the sorting thread to a target number of element
+    /// accesses per second, from 1 op/s up to unthrottled.
+    ///
+    /// In deadline mode each access adds its share of a second to a debt
+    /// and the thread only sleeps once that debt reaches a batch, until
+    /// an absolute deadline, so the average rate holds regardless of the
+    /// kernel's sleep granularity. In frame mode the render loop hands
+    /// out `rate * dt` accesses each frame and the sorting thread blocks
+    /// once they are spent. Time spent blocked is measured separately so
+    /// it can be subtracted from the elapsed time.
+    class Pacer
+    {
+    public:
+
+        using size_type         = std::size_t;
+        using rate_type         = double;
+        using clock_type        = std::chrono::steady_clock;
+        using time_point_type   = clock_type::time_point;
+        using duration_type     = std::chrono::nanoseconds;
+        using seconds_type      = std::chrono::duration<double>;
+
+        enum class Mode : short
+        {
+            DEADLINE,
+            FRAME
+        };
+
+        static constexpr auto unthrottled   { std::numeric_limits<rate_type>::infinity() };
+        static constexpr auto min_rate      { 1.0 };
+        static constexpr auto max_rate      { 1e8 };
+
+    public:
+
+        explicit Pacer(rate_type rate = unthrottled, Mode mode = Mode::DEADLINE) noexcept
+            : m_rate{ _S_clamp(rate) }
+            , m_mode{ mode }
+        { }
+
+        Pacer(const Pacer&) = delete;
+        auto operator= (const Pacer&) -> Pacer& = delete;
+
+        /// Binds the stop token of the thread about to run a sort and
+        /// clears the debt and stall time left over from the last one.
+        auto bind(std::stop_token token) noexcept
+            -> void
+        {
+            {
+                auto lock = std::scoped_lock{ m_mutex };
+                m_token     = std::move(token);
+                m_budget    = 0.0;
+                m_generation.fetch_add(1u, std::memory_order_release);
+            }
+
+            m_credit = size_type{};
+            m_stalled.store(duration_type::rep{}, std::memory_order_relaxed);
+        }
+
+        /// Accounts for `ops` element accesses, blocking if the sorting
+        /// thread(s) are ahead of the target rate.
+        auto pace(size_type ops = 1uL)
+            -> void
+        {
+            auto rate { m_rate.load(std::memory_order_relaxed) };
+
+            if (std::isinf(rate))
+                return;
+
+            auto lock = std::scoped_lock{ m_pace_mutex };
+
+            if (auto gen { m_generation.load(std::memory_order_acquire) }; gen != m_seen)
+            {
+                m_seen      = gen;
+                m_deadline  = clock_type::now();
+                m_debt      = 0.0;
+                m_credit    = size_type{};
+            }
+
+            if (m_mode.load(std::memory_order_relaxed) == Mode::FRAME)
+                _M_pace_frame(ops);
+            else
+                _M_pace_deadline(ops, rate);
+        }
+
+        /// Called once per rendered frame. Releases `rate * dt` accesses
+        /// to the sorting thread when frame locked.
+        auto frame(seconds_type dt)
+            -> void
+        {
+            auto rate { m_rate.load(std::memory_order_relaxed) };
+
+            if (m_mode.load(std::memory_order_relaxed) != Mode::FRAME || std::isinf(rate))
+                return;
+
+            {
+                auto lock = std::scoped_lock{ m_mutex };
+                m_budget = std::min(m_budget + rate * dt.count(), rate * s_max_frame.count() + 1.0);
+            }
+
+            m_cv.notify_all();
+        }
+
+        auto rate() const noexcept
+            -> rate_type
+        { return m_rate.load(std::memory_order_relaxed); }
+
+        auto throttled() const noexcept
+            -> bool
+        { return !std::isinf(rate()); }
+
+        auto set_rate(rate_type rate)
+            -> void
+        {
+            m_rate.store(_S_clamp(rate), std::memory_order_relaxed);
+            _M_wake();
+        }
+
+        /// Multiplies the rate by `factor`. Going past `max_rate` turns
+        /// throttling off; scaling down from unthrottled starts again
+        /// from `max_rate`.
+        auto scale_rate(double factor)
+            -> void
+        {
+            auto rate { this->rate() };
+            set_rate(std::isinf(rate) ? (factor < 1.0 ? max_rate * factor : rate) : rate * factor);
+        }
+
+        auto mode() const noexcept
+            -> Mode
+        { return m_mode.load(std::memory_order_relaxed); }
+
+        auto toggle_mode()
+            -> void
+        {
+            m_mode.store(mode() == Mode::FRAME ? Mode::DEADLINE : Mode::FRAME, std::memory_order_relaxed);
+            _M_wake();
+        }
+
+        /// Time the sorting thread has spent blocked since the last `bind`.
+        auto stalled() const noexcept
+            -> duration_type
+        { return duration_type{ m_stalled.load(std::memory_order_relaxed) }; }
+
+    private:
+
+        /// Debt below which no sleep is attempted and the furthest the
+        /// thread may fall behind before the deadline is reset instead
+        /// of bursting to catch up.
+        static constexpr auto s_batch       { std::chrono::microseconds{ 1000 } };
+        static constexpr auto s_max_lag     { std::chrono::milliseconds{ 50 } };
+        static constexpr auto s_max_frame   { seconds_type{ 0.1 } };
+
+        static constexpr auto _S_clamp(rate_type rate) noexcept
+            -> rate_type
+        { return rate > max_rate ? unthrottled : std::max(rate, min_rate); }
+
+        auto _M_pace_deadline(size_type ops, rate_type rate)
+            -> void
+        {
+            m_debt += static_cast<double>(ops) * 1e9 / rate;
+
+            if (m_debt < static_cast<double>(duration_type{ s_batch }.count()))
+                return;
+
+            auto step = duration_type{ static_cast<duration_type::rep>(m_debt) };
+            m_debt      -= static_cast<double>(step.count());
+            m_deadline  += step;
+
+            auto now { clock_type::now() };
+
+            if (now - m_deadline > s_max_lag)
+                m_deadline = now;
+            else if (m_deadline > now)
+                _M_stall([this, gen = m_seen](auto& lock)
+                {
+                    return m_cv.wait_until(lock, m_token, m_deadline, [this, gen]
+                    { return m_generation.load(std::memory_order_acquire) != gen; });
+                });
+        }
+
+        auto _M_pace_frame(size_type ops)
+            -> void
+        {
+            while (m_credit < ops)
+            {
+                auto gen { m_seen };
+                auto lock = std::unique_lock{ m_mutex };
+
+                if (m_budget < 1.0)
+                {
+                    auto start { clock_type::now() };
+                    m_cv.wait(lock, m_token, [this, gen]
+                    { return m_budget >= 1.0 || m_generation.load(std::memory_order_acquire) != gen; });
+                    m_stalled.fetch_add(std::chrono::duration_cast<duration_type>(clock_type::now() - start).count(), std::memory_order_relaxed);
+                }
+
+                if (m_token.stop_requested())
+                    throw sort_cancelled{};
+
+                if (m_generation.load(std::memory_order_acquire) != gen)
+                    return;
+
+                auto whole { std::floor(m_budget) };
+                m_budget -= whole;
+                m_credit += static_cast<size_type>(whole);
+            }
+
+            m_credit -= ops;
+        }
+
+        template<typename F>
+        auto _M_stall(F&& wait)
+            -> void
+        {
+            auto start  { clock_type::now() };
+            auto lock   = std::unique_lock{ m_mutex };
+            wait(lock);
+            m_stalled.fetch_add(std::chrono::duration_cast<duration_type>(clock_type::now() - start).count(), std::memory_order_relaxed);
+
+            if (m_token.stop_requested())
+                throw sort_cancelled{};
+        }
+
+        auto _M_wake()
+            -> void
+        {
+            {
+                auto lock = std::scoped_lock{ m_mutex };
+                m_budget = 0.0;
+                m_generation.fetch_add(1u, std::memory_order_release);
+            }
+
+            m_cv.notify_all();
+        }
+
+    private:
+        std::atomic<rate_type>          m_rate;
+        std::atomic<Mode>               m_mode;
+        std::atomic<std::uint32_t>      m_generation    { 0u };
+        std::atomic<duration_type::rep> m_stalled       { duration_type::rep{} };
+
+        std::mutex                      m_mutex;
+        std::condition_variable_any     m_cv;
+        std::stop_token                 m_token         { };
+        double                          m_budget        { 0.0 };
+
+        /// Sorting side state. Parallel sorts pace from several threads,
+        /// which then share the one rate.
+        std::mutex                      m_pace_mutex;
+        std::uint32_t                   m_seen          { 0u };
+        time_point_type                 m_deadline      { };
+        double                          m_debt          { 0.0 };
+        size_type                       m_credit        { size_type{} };
+
+    };  /// class Pacer
+
+}  /// namespace sv
+
+#endif  // SV_PACER
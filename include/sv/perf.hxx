@@ -0,0 +1,606 @@
+#ifndef SV_PERF
+#   define SV_PERF
+
+#include <linux/perf_event.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sv/thread_pool.hxx>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+using namespace std::literals;
+
+namespace sv
+{
+    /// Where counts come from, best first. VMs and containers often
+    /// forbid hardware events but not software ones; failing both, the
+    /// threads' CPU clocks are read instead.
+    enum class CounterSource { HARDWARE, SOFTWARE, CLOCK };
+
+    enum class PerfEvent : std::size_t
+    {
+        CYCLES,
+        INSTRUCTIONS,
+        L1D_MISSES,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        CPU_TIME,
+        PAGE_FAULTS,
+        CONTEXT_SWITCHES
+    };
+
+    inline constexpr auto perf_events = std::array{
+        PerfEvent::CYCLES,
+        PerfEvent::INSTRUCTIONS,
+        PerfEvent::L1D_MISSES,
+        PerfEvent::LLC_MISSES,
+        PerfEvent::BRANCH_MISSES,
+        PerfEvent::CPU_TIME,
+        PerfEvent::PAGE_FAULTS,
+        PerfEvent::CONTEXT_SWITCHES
+    };
+
+    /// Stages of an algorithm whose counts are kept apart.
+    enum class PerfPhase : std::size_t
+    { PARTITION, MERGE, HEAPIFY, INSERTION };
+
+    inline constexpr auto perf_phases = std::array{
+        PerfPhase::PARTITION,
+        PerfPhase::MERGE,
+        PerfPhase::HEAPIFY,
+        PerfPhase::INSERTION
+    };
+
+    inline auto event_name(PerfEvent event) noexcept
+        -> std::string_view
+    {
+        switch (event)
+        {
+            case PerfEvent::CYCLES:             return "cycles"sv;
+            case PerfEvent::INSTRUCTIONS:       return "instructions"sv;
+            case PerfEvent::L1D_MISSES:         return "l1d_misses"sv;
+            case PerfEvent::LLC_MISSES:         return "llc_misses"sv;
+            case PerfEvent::BRANCH_MISSES:      return "branch_misses"sv;
+            case PerfEvent::CPU_TIME:           return "cpu_ns"sv;
+            case PerfEvent::PAGE_FAULTS:        return "page_faults"sv;
+            case PerfEvent::CONTEXT_SWITCHES:   return "context_switches"sv;
+        }
+
+        return "unknown"sv;
+    }
+
+    inline auto phase_name(PerfPhase phase) noexcept
+        -> std::string_view
+    {
+        switch (phase)
+        {
+            case PerfPhase::PARTITION:  return "partition"sv;
+            case PerfPhase::MERGE:      return "merge"sv;
+            case PerfPhase::HEAPIFY:    return "heapify"sv;
+            case PerfPhase::INSERTION:  return "insertion"sv;
+        }
+
+        return "unknown"sv;
+    }
+
+    inline auto source_name(CounterSource source) noexcept
+        -> std::string_view
+    {
+        switch (source)
+        {
+            case CounterSource::HARDWARE:   return "hardware"sv;
+            case CounterSource::SOFTWARE:   return "software"sv;
+            case CounterSource::CLOCK:      return "clock"sv;
+        }
+
+        return "unknown"sv;
+    }
+
+    /// The best source to try, capped by the `SV_COUNTERS` environment
+    /// variable (`software` or `clock`) so the fallbacks can be checked
+    /// on hosts that allow more.
+    inline auto counter_limit() noexcept
+        -> CounterSource
+    {
+        static const auto limit = []
+        {
+            if (auto cap { std::getenv("SV_COUNTERS") }; cap)
+            {
+                if (cap == "software"sv)
+                    return CounterSource::SOFTWARE;
+                if (cap == "clock"sv)
+                    return CounterSource::CLOCK;
+            }
+
+            return CounterSource::HARDWARE;
+        }();
+
+        return limit;
+    }
+
+    /// Event totals. Events the source could not count are left out.
+    struct PerfCounts
+    {
+        using value_type = std::uint64_t;
+
+        std::array<value_type, perf_events.size()>  values      { };
+        std::bitset<perf_events.size()>             counted     { };
+        CounterSource                               source      { CounterSource::CLOCK };
+
+        auto has(PerfEvent event) const noexcept
+            -> bool
+        { return counted[static_cast<std::size_t>(event)]; }
+
+        auto operator[] (PerfEvent event) const noexcept
+            -> value_type
+        { return values[static_cast<std::size_t>(event)]; }
+
+        auto set(PerfEvent event, value_type value) noexcept
+            -> void
+        {
+            values[static_cast<std::size_t>(event)] = value;
+            counted.set(static_cast<std::size_t>(event));
+        }
+
+        /// Instructions per cycle, or zero if either was not counted.
+        auto ipc() const noexcept
+            -> double
+        {
+            if (!has(PerfEvent::CYCLES) || !has(PerfEvent::INSTRUCTIONS) || (*this)[PerfEvent::CYCLES] == 0uL)
+                return 0.0;
+
+            return static_cast<double>((*this)[PerfEvent::INSTRUCTIONS]) / static_cast<double>((*this)[PerfEvent::CYCLES]);
+        }
+
+        auto operator+= (const PerfCounts& other) noexcept
+            -> PerfCounts&
+        {
+            for (auto e { 0uL }; e < values.size(); ++e)
+                values[e] += other.values[e];
+
+            counted |= other.counted;
+            return *this;
+        }
+
+        /// Multiplexed counts are scaled estimates and may step back
+        /// slightly, so differences stop at zero.
+        auto operator- (const PerfCounts& earlier) const noexcept
+            -> PerfCounts
+        {
+            auto delta { *this };
+
+            for (auto e { 0uL }; e < values.size(); ++e)
+                delta.values[e] = values[e] > earlier.values[e] ? values[e] - earlier.values[e] : 0uL;
+
+            return delta;
+        }
+    };
+
+    /// The counters of one thread: a group of hardware events, a group
+    /// of software events, or its CPU clock, whichever the host allows.
+    /// User space only, so what is counted is the algorithm and not the
+    /// syscalls made to read it.
+    ///
+    /// The thread it counts also keeps its current phase here; every
+    /// switch charges what was counted since the last one to the phase
+    /// being left.
+    class ThreadCounters
+    {
+    public:
+
+        using value_type    = PerfCounts::value_type;
+
+    public:
+
+        ThreadCounters(parallel::ThreadId thread, CounterSource limit)
+            : m_hardware{ }
+            , m_software{ }
+            , m_clock{ CLOCK_THREAD_CPUTIME_ID }
+            , m_clock_start{ 0uL }
+            , m_phase{ std::nullopt }
+            , m_mark{ }
+            , m_phases{ }
+        {
+            if (limit == CounterSource::HARDWARE)
+                _M_open(m_hardware, thread.tid, {
+                    Event{ PerfEvent::CYCLES,          PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+                    Event{ PerfEvent::INSTRUCTIONS,    PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+                    Event{ PerfEvent::L1D_MISSES,      PERF_TYPE_HW_CACHE, s_l1d_read_miss },
+                    Event{ PerfEvent::LLC_MISSES,      PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+                    Event{ PerfEvent::BRANCH_MISSES,   PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+                });
+
+            if (limit != CounterSource::CLOCK)
+                _M_open(m_software, thread.tid, {
+                    Event{ PerfEvent::CPU_TIME,         PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+                    Event{ PerfEvent::PAGE_FAULTS,      PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+                    Event{ PerfEvent::CONTEXT_SWITCHES, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES }
+                });
+
+            if (m_software.leader < 0 && ::pthread_getcpuclockid(thread.handle, &m_clock) == 0)
+                m_clock_start = _M_clock();
+
+            m_mark = read();
+        }
+
+        ThreadCounters(const ThreadCounters&) = delete;
+        auto operator= (const ThreadCounters&) -> ThreadCounters& = delete;
+
+        ~ThreadCounters() noexcept
+        {
+            _M_close(m_hardware);
+            _M_close(m_software);
+        }
+
+        auto source() const noexcept
+            -> CounterSource
+        {
+            return m_hardware.leader >= 0 ? CounterSource::HARDWARE
+                 : m_software.leader >= 0 ? CounterSource::SOFTWARE
+                 : CounterSource::CLOCK;
+        }
+
+        /// Counts since the counters were opened. Any thread may read them.
+        auto read() const noexcept
+            -> PerfCounts
+        {
+            auto counts = PerfCounts{};
+            counts.source = source();
+
+            _M_read(m_hardware, counts);
+            _M_read(m_software, counts);
+
+            if (m_software.leader < 0)
+                counts.set(PerfEvent::CPU_TIME, _M_clock() - m_clock_start);
+
+            return counts;
+        }
+
+        /// The counters the calling thread is charging phases to, if any.
+        static auto current() noexcept
+            -> ThreadCounters*
+        { return s_current; }
+
+        static auto make_current(ThreadCounters* counters) noexcept
+            -> void
+        { s_current = counters; }
+
+        auto phase() const noexcept
+            -> std::optional<PerfPhase>
+        { return m_phase; }
+
+        /// Charges the counts since the last switch to the current phase
+        /// and moves to `phase`. Only the counted thread may call this.
+        auto switch_phase(std::optional<PerfPhase> phase) noexcept
+            -> void
+        {
+            auto now { read() };
+
+            if (m_phase)
+            {
+                auto delta { now - m_mark };
+                auto& totals = m_phases[static_cast<std::size_t>(*m_phase)];
+
+                for (auto e { 0uL }; e < totals.size(); ++e)
+                    totals[e].fetch_add(delta.values[e], std::memory_order_relaxed);
+            }
+
+            m_mark  = now;
+            m_phase = phase;
+        }
+
+        auto phase_counts(PerfPhase phase) const noexcept
+            -> PerfCounts
+        {
+            const auto& totals = m_phases[static_cast<std::size_t>(phase)];
+            auto counts = PerfCounts{};
+
+            for (auto e { 0uL }; e < totals.size(); ++e)
+                counts.values[e] = totals[e].load(std::memory_order_relaxed);
+
+            counts.counted = m_mark.counted;
+            counts.source  = m_mark.source;
+            return counts;
+        }
+
+    private:
+
+        struct Event
+        {
+            PerfEvent       event;
+            std::uint32_t   type;
+            std::uint64_t   config;
+        };
+
+        struct Group
+        {
+            int                     leader  { -1 };
+            std::vector<int>        fds     { };
+            std::vector<PerfEvent>  events  { };
+        };
+
+        static constexpr auto s_l1d_read_miss {
+            std::uint64_t{ PERF_COUNT_HW_CACHE_L1D }
+          | (std::uint64_t{ PERF_COUNT_HW_CACHE_OP_READ } << 8uL)
+          | (std::uint64_t{ PERF_COUNT_HW_CACHE_RESULT_MISS } << 16uL)
+        };
+
+        inline static thread_local ThreadCounters* s_current { nullptr };
+
+        /// Opens `events` as one group on thread `tid`, led by the first.
+        /// A group without its leader is not opened at all; members the
+        /// host does not support are left out.
+        static auto _M_open(Group& group, pid_t tid, std::initializer_list<Event> events) noexcept
+            -> void
+        {
+            for (const auto& [event, type, config] : events)
+            {
+                auto attr = perf_event_attr{};
+                attr.size           = sizeof(perf_event_attr);
+                attr.type           = type;
+                attr.config         = config;
+                attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv     = 1;
+
+                auto fd { static_cast<int>(::syscall(SYS_perf_event_open, &attr, tid, -1, group.leader, 0uL)) };
+
+                if (fd < 0)
+                {
+                    if (group.leader < 0)
+                        return;
+
+                    continue;
+                }
+
+                if (group.leader < 0)
+                    group.leader = fd;
+
+                group.fds.push_back(fd);
+                group.events.push_back(event);
+            }
+        }
+
+        static auto _M_close(Group& group) noexcept
+            -> void
+        {
+            for (auto fd : group.fds)
+                ::close(fd);
+
+            group = Group{};
+        }
+
+        /// Reads a whole group at once, scaling each count up by the
+        /// share of the time the group was actually on the PMU.
+        static auto _M_read(const Group& group, PerfCounts& counts) noexcept
+            -> void
+        {
+            if (group.leader < 0)
+                return;
+
+            auto buffer = std::array<std::uint64_t, 3uL + perf_events.size()>{};
+            auto bytes  { (3uL + group.events.size()) * sizeof(std::uint64_t) };
+
+            if (::read(group.leader, buffer.data(), bytes) != static_cast<ssize_t>(bytes))
+                return;
+
+            auto enabled { buffer[1] };
+            auto running { buffer[2] };
+
+            /// The group never got onto the PMU, so nothing was counted.
+            if (running == 0uL && enabled != 0uL)
+                return;
+
+            for (auto i { 0uL }; i < group.events.size(); ++i)
+            {
+                auto value { buffer[3uL + i] };
+
+                if (running != 0uL && running < enabled)
+                    value = static_cast<std::uint64_t>(static_cast<double>(value) * static_cast<double>(enabled) / static_cast<double>(running));
+
+                counts.set(group.events[i], value);
+            }
+        }
+
+        auto _M_clock() const noexcept
+            -> value_type
+        {
+            auto ts = timespec{};
+
+            if (::clock_gettime(m_clock, &ts) != 0)
+                return m_clock_start;
+
+            return static_cast<value_type>(ts.tv_sec) * 1'000'000'000uL + static_cast<value_type>(ts.tv_nsec);
+        }
+
+    private:
+        Group                       m_hardware;
+        Group                       m_software;
+        clockid_t                   m_clock;
+        value_type                  m_clock_start;
+        std::optional<PerfPhase>    m_phase;
+        PerfCounts                  m_mark;
+        std::array<std::array<std::atomic<value_type>, perf_events.size()>, perf_phases.size()> m_phases;
+
+    };  /// class ThreadCounters
+
+    /// Counts one run of an algorithm on the thread that starts it and,
+    /// optionally, other threads it hands work to. Totals are summed
+    /// over every thread; phases are charged on the starting thread
+    /// only. `start` and `stop` belong to the counted thread, while the
+    /// totals may be read from any, eg. the render loop mid-sort.
+    class PerfCounters
+    {
+    public:
+
+        PerfCounters() noexcept
+            : m_threads{ }
+            , m_totals{ }
+            , m_phases{ }
+            , m_counting{ false }
+        { }
+
+        PerfCounters(const PerfCounters&) = delete;
+        auto operator= (const PerfCounters&) -> PerfCounters& = delete;
+
+        ~PerfCounters() noexcept
+        { stop(); }
+
+        auto start(std::span<const parallel::ThreadId> others = {}, bool phases = true)
+            -> void
+        {
+            stop();
+
+            auto lock   = std::scoped_lock{ m_mutex };
+            auto self   = std::make_unique<ThreadCounters>(parallel::ThreadId::current(), counter_limit());
+            auto source { self->source() };
+
+            if (phases)
+                ThreadCounters::make_current(self.get());
+
+            m_threads.push_back(std::move(self));
+
+            for (const auto& thread : others)
+                m_threads.push_back(std::make_unique<ThreadCounters>(thread, source));
+
+            m_totals    = PerfCounts{};
+            m_phases    = {};
+            m_counting  = true;
+        }
+
+        /// Closes the counters, keeping their final totals.
+        auto stop() noexcept
+            -> PerfCounts
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+
+            if (!m_counting)
+                return m_totals;
+
+            if (auto self { ThreadCounters::current() }; self == m_threads.front().get())
+            {
+                self->switch_phase(std::nullopt);
+                ThreadCounters::make_current(nullptr);
+            }
+
+            m_totals = _M_totals();
+
+            for (auto phase : perf_phases)
+                m_phases[static_cast<std::size_t>(phase)] = m_threads.front()->phase_counts(phase);
+
+            m_threads.clear();
+            m_counting = false;
+
+            return m_totals;
+        }
+
+        auto counting() const noexcept
+            -> bool
+        { return m_counting; }
+
+        /// Live totals while counting, the last run's afterwards.
+        auto totals() const
+            -> PerfCounts
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            return m_counting ? _M_totals() : m_totals;
+        }
+
+        auto phases() const
+            -> std::array<PerfCounts, perf_phases.size()>
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+
+            if (!m_counting)
+                return m_phases;
+
+            auto phases = std::array<PerfCounts, perf_phases.size()>{};
+
+            for (auto phase : perf_phases)
+                phases[static_cast<std::size_t>(phase)] = m_threads.front()->phase_counts(phase);
+
+            return phases;
+        }
+
+    private:
+
+        auto _M_totals() const noexcept
+            -> PerfCounts
+        {
+            auto totals = PerfCounts{};
+
+            if (m_threads.empty())
+                return totals;
+
+            totals.source = m_threads.front()->source();
+
+            for (const auto& thread : m_threads)
+                totals += thread->read();
+
+            return totals;
+        }
+
+    private:
+        mutable std::mutex                                  m_mutex;
+        std::vector<std::unique_ptr<ThreadCounters>>        m_threads;
+        PerfCounts                                          m_totals;
+        std::array<PerfCounts, perf_phases.size()>          m_phases;
+        std::atomic<bool>                                   m_counting;
+
+    };  /// class PerfCounters
+
+    /// Charges what the calling thread does until the scope ends to
+    /// `phase`, when it is being counted. Entering the phase the thread
+    /// is already in does nothing, so scopes may sit in recursive code
+    /// and a phase's counts never include themselves twice.
+    class PhaseScope
+    {
+    public:
+
+        explicit PhaseScope(PerfPhase phase) noexcept
+            : m_counters{ ThreadCounters::current() }
+            , m_previous{ std::nullopt }
+        {
+            if (m_counters && m_counters->phase() != phase)
+            {
+                m_previous = m_counters->phase();
+                m_counters->switch_phase(phase);
+            }
+            else
+                m_counters = nullptr;
+        }
+
+        PhaseScope(const PhaseScope&) = delete;
+        auto operator= (const PhaseScope&) -> PhaseScope& = delete;
+
+        ~PhaseScope() noexcept
+        {
+            if (m_counters)
+                m_counters->switch_phase(m_previous);
+        }
+
+    private:
+        ThreadCounters*             m_counters;
+        std::optional<PerfPhase>    m_previous;
+
+    };  /// class PhaseScope
+
+}  /// namespace sv
+
+#endif  // SV_PERF
@@ -0,0 +1,457 @@
+#ifndef SV_RACE
+#   define SV_RACE
+
+#include <SFML/Graphics.hpp>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <sv/control.hxx>
+#include <sv/elements.hxx>
+#include <sv/inputs.hxx>
+#include <sv/pacer.hxx>
+#include <sv/perf.hxx>
+#include <sv/simd.hxx>
+#include <sv/sorter.hxx>
+#include <sv/thread_pool.hxx>
+#include <sv/viewer.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+namespace sv
+{
+    enum class RaceState : short
+    { WAITING, RUNNING, FINISHED, CANCELLED };
+
+    /// One algorithm's place in a race, as of the moment it was taken.
+    struct Standing
+    {
+        using size_type     = std::size_t;
+        using duration_type = std::chrono::nanoseconds;
+
+        std::string     name;
+        size_type       racer;
+        RaceState       state;
+        size_type       place;
+        bool            sorted;
+        duration_type   elapsed;
+        size_type       comparisons;
+        size_type       reads;
+        size_type       writes;
+        size_type       swaps;
+        PerfCounts      counters;
+
+        /// Element accesses, which is what the pacer meters.
+        auto operations() const noexcept
+            -> size_type
+        { return reads + writes; }
+    };
+
+    /// Runs several algorithms side by side, each on its own copy of
+    /// the same seeded input, its own thread pinned to its own core and
+    /// its own tile of the window. Every racer has a pacer and a share
+    /// of the hardware threads as a pool of its own, so one blocking
+    /// never holds up another and no racer runs another's tasks or
+    /// counts them in its pool statistics, but all of them are set
+    /// to the same rate and fed from the same frame clock, and they are
+    /// released together: at a finite rate the finishing order is the
+    /// order of element accesses, unthrottled it is wall time.
+    class Race
+    {
+    public:
+
+        using size_type         = std::size_t;
+        using clock_type        = std::chrono::steady_clock;
+        using time_point_type   = clock_type::time_point;
+        using duration_type     = std::chrono::nanoseconds;
+        using map_type          = Sorter::map_type;
+
+        struct Racer
+        {
+            std::string                             name;
+            Sorter::function_type                   algorithm;
+            std::shared_ptr<Pacer>                  pacer;
+            std::shared_ptr<Elements>               elems;
+            std::shared_ptr<Viewer>                 viewer;
+            std::shared_ptr<Control>                control;
+            std::unique_ptr<parallel::ThreadPool>   pool;
+            PerfCounters                            perf;
+            std::atomic<RaceState>                  state       { RaceState::WAITING };
+            std::atomic<time_point_type>            finish      { time_point_type{} };
+            std::atomic<bool>                       sorted      { false };
+            std::jthread                            thread      { };
+        };
+
+    public:
+
+        /// Tiles `width` by `height` with one viewer per name in `names`,
+        /// laid out in as square a grid as fits. Every racer sorts
+        /// `elements` elements.
+        Race(
+            const std::vector<std::string>& names,
+            const map_type& algorithms,
+            float width,
+            float height,
+            size_type elements,
+            Pacer::rate_type rate
+        )
+            : m_racers{ }
+            , m_input{ }
+            , m_ready{ nullptr }
+            , m_start{ time_point_type{} }
+            , m_columns{ columns(names.size()) }
+            , m_rows{ (names.size() + m_columns - 1uL) / std::max(m_columns, 1uL) }
+            , m_tile_width{ width / static_cast<float>(std::max(m_columns, 1uL)) }
+            , m_tile_height{ height / static_cast<float>(std::max(m_rows, 1uL)) }
+        {
+            for (auto r { 0uL }; r < names.size(); ++r)
+            {
+                auto racer = std::make_unique<Racer>();
+                auto tile  { _M_tile(r) };
+
+                racer->name         = names[r];
+                racer->algorithm    = std::get<2>(algorithms.at(names[r]));
+                racer->pacer        = std::make_shared<Pacer>(rate);
+                racer->control      = std::make_shared<Control>();
+                racer->pool         = std::make_unique<parallel::ThreadPool>(
+                    std::max(1uL, std::thread::hardware_concurrency() / names.size())
+                );
+                racer->elems        = std::make_shared<Elements>(
+                    m_tile_height - s_gap - (0.005f * m_tile_height),
+                    elements,
+                    racer->pacer,
+                    nullptr
+                );
+                racer->viewer       = std::make_shared<Viewer>(
+                    static_cast<Viewer::size_type>(m_tile_width - s_gap),
+                    static_cast<Viewer::size_type>(m_tile_height - s_gap),
+                    racer->elems
+                );
+
+                racer->elems->control(racer->control);
+                racer->viewer->setPosition(tile.left, tile.top);
+                m_racers.push_back(std::move(racer));
+            }
+        }
+
+        /// Tiles per row for a race of `racers`.
+        static auto columns(size_type racers) noexcept
+            -> size_type
+        { return static_cast<size_type>(std::ceil(std::sqrt(static_cast<double>(racers)))); }
+
+        Race(const Race&) = delete;
+        auto operator= (const Race&) -> Race& = delete;
+
+        ~Race() noexcept
+        { stop(); }
+
+        /// Deals every racer the same `shape` of input from `seed`.
+        auto generate(InputShape shape, std::uint64_t seed)
+            -> void
+        {
+            if (m_racers.empty())
+                return;
+
+            stop();
+
+            const auto& first = m_racers.front()->elems;
+            first->generate(shape, seed);
+            m_input = first->items();
+
+            _M_deal();
+        }
+
+        /// Starts every racer on its own pinned thread from a fresh copy
+        /// of the input. None of them touches its elements until all are
+        /// ready, and the race's clock starts when the last one is.
+        auto start()
+            -> void
+        {
+            stop();
+            _M_deal();
+
+            /// Until the last racer is ready, a race has no elapsed time.
+            m_start = time_point_type{};
+            m_ready = std::make_unique<barrier_type>(static_cast<std::ptrdiff_t>(m_racers.size()), Starter{ this });
+
+            for (auto r { 0uL }; r < m_racers.size(); ++r)
+            {
+                m_racers[r]->state = RaceState::RUNNING;
+                m_racers[r]->thread = std::jthread{ [this, r](std::stop_token token)
+                { _M_run(*m_racers[r], r, std::move(token)); } };
+            }
+        }
+
+        /// Cancels every racer still running and waits for them.
+        auto stop() noexcept
+            -> void
+        {
+            for (auto& racer : m_racers)
+            {
+                racer->thread.request_stop();
+                racer->control->resume();
+            }
+
+            for (auto& racer : m_racers)
+                if (racer->thread.joinable())
+                    racer->thread.join();
+        }
+
+        auto running() const noexcept
+            -> bool
+        {
+            return std::ranges::any_of(m_racers, [](const auto& racer)
+            { return racer->state == RaceState::RUNNING; });
+        }
+
+        auto paused() const noexcept
+            -> bool
+        { return !m_racers.empty() && m_racers.front()->control->paused(); }
+
+        auto toggle_pause() noexcept
+            -> void
+        {
+            auto pause { !paused() };
+
+            for (auto& racer : m_racers)
+                pause ? racer->control->pause() : racer->control->resume();
+        }
+
+        /// Releases each racer's share of frame budget from one clock.
+        auto frame(Pacer::seconds_type dt)
+            -> void
+        {
+            for (auto& racer : m_racers)
+                racer->pacer->frame(dt);
+        }
+
+        auto scale_rate(double factor)
+            -> void
+        {
+            for (auto& racer : m_racers)
+                racer->pacer->scale_rate(factor);
+        }
+
+        auto toggle_frame_lock()
+            -> void
+        {
+            for (auto& racer : m_racers)
+                racer->pacer->toggle_mode();
+        }
+
+        auto render()
+            -> void
+        {
+            for (auto& racer : m_racers)
+                racer->viewer->render();
+        }
+
+        auto racers() const noexcept
+            -> const std::vector<std::unique_ptr<Racer>>&
+        { return m_racers; }
+
+        auto pacer() const noexcept
+            -> const Pacer&
+        { return *m_racers.front()->pacer; }
+
+        /// Top left corner and size of racer `r`'s tile.
+        auto tile(size_type r) const noexcept
+            -> sf::FloatRect
+        { return _M_tile(r); }
+
+        /// Finishers by finishing time, then by element accesses; the
+        /// racers still running after them, then those cancelled.
+        auto standings() const
+            -> std::vector<Standing>
+        {
+            auto now        { clock_type::now() };
+            auto start      { m_start.load() };
+            auto standings  = std::vector<Standing>{};
+
+            for (auto i { 0uL }; i < m_racers.size(); ++i)
+            {
+                const auto& racer = m_racers[i];
+                const auto& [c, r, w, s] = racer->elems->counters();
+                auto state  { racer->state.load() };
+                auto end    { state == RaceState::RUNNING ? now : racer->finish.load() };
+
+                standings.push_back(Standing{
+                    racer->name,
+                    i,
+                    state,
+                    0uL,
+                    racer->sorted,
+                    start == time_point_type{} || state == RaceState::WAITING
+                        ? duration_type::zero()
+                        : std::chrono::duration_cast<duration_type>(end - start),
+                    c, r, w, s,
+                    racer->perf.totals()
+                });
+            }
+
+            std::ranges::stable_sort(standings, [](const auto& a, const auto& b)
+            {
+                if (a.state != b.state)
+                    return _S_rank(a.state) < _S_rank(b.state);
+
+                if (a.state != RaceState::FINISHED)
+                    return false;
+
+                return a.elapsed < b.elapsed || (a.elapsed == b.elapsed && a.operations() < b.operations());
+            });
+
+            for (auto i { 0uL }; i < standings.size() && standings[i].state == RaceState::FINISHED; ++i)
+                standings[i].place = i + 1uL;
+
+            return standings;
+        }
+
+    private:
+
+        /// Starts the race's clock once every racer is ready.
+        struct Starter
+        {
+            Race* race;
+
+            auto operator() () noexcept
+                -> void
+            { race->m_start = clock_type::now(); }
+        };
+
+        using barrier_type = std::barrier<Starter>;
+
+        static constexpr auto s_gap { 4.0f };
+
+        static constexpr auto _S_rank(RaceState state) noexcept
+            -> int
+        {
+            switch (state)
+            {
+                case RaceState::FINISHED:   return 0;
+                case RaceState::RUNNING:    return 1;
+                case RaceState::WAITING:    return 2;
+                case RaceState::CANCELLED:  return 3;
+            }
+
+            return 4;
+        }
+
+        /// Keeps the calling thread on the `n`th core it is allowed to
+        /// run on, wrapping round when there are more racers than cores.
+        static auto _S_pin(size_type n) noexcept
+            -> void
+        {
+            auto allowed = cpu_set_t{};
+
+            if (::sched_getaffinity(0, sizeof(cpu_set_t), &allowed) != 0)
+                return;
+
+            auto cores = std::vector<int>{};
+
+            for (auto cpu { 0 }; cpu < CPU_SETSIZE; ++cpu)
+                if (CPU_ISSET(cpu, &allowed))
+                    cores.push_back(cpu);
+
+            if (cores.empty())
+                return;
+
+            auto set = cpu_set_t{};
+            CPU_ZERO(&set);
+            CPU_SET(cores[n % cores.size()], &set);
+
+            if (::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set_t), &set) != 0)
+                std::clog << "Could not pin racer " << n << " to core " << cores[n % cores.size()] << "." << std::endl;
+        }
+
+        auto _M_tile(size_type r) const noexcept
+            -> sf::FloatRect
+        {
+            return sf::FloatRect{
+                static_cast<float>(r % m_columns) * m_tile_width,
+                static_cast<float>(r / m_columns) * m_tile_height,
+                m_tile_width - s_gap,
+                m_tile_height - s_gap
+            };
+        }
+
+        auto _M_deal()
+            -> void
+        {
+            for (auto& racer : m_racers)
+            {
+                racer->elems->items() = m_input;
+                racer->elems->reset_counters();
+                racer->viewer->unmark_range(0uL, racer->elems->size());
+                racer->viewer->touch_all();
+                racer->state    = RaceState::WAITING;
+                racer->sorted   = false;
+            }
+        }
+
+        auto _M_run(Racer& racer, size_type r, std::stop_token token) noexcept
+            -> void
+        {
+            _S_pin(r);
+
+            auto lent = parallel::ThreadPool::Scope{ *racer.pool };
+
+            racer.pacer->bind(token);
+            racer.control->bind(std::move(token));
+            racer.viewer->unmark_range(0uL, racer.elems->size());
+            racer.elems->reset_counters();
+
+            m_ready->arrive_and_wait();
+
+            try
+            {
+                racer.perf.start({}, false);
+                racer.algorithm(racer.elems, racer.viewer);
+                racer.finish = clock_type::now();
+                racer.perf.stop();
+
+                const auto& items = racer.elems->items();
+                racer.sorted = simd::sorted_until(items.data(), items.size()) == items.size();
+                racer.state  = RaceState::FINISHED;
+                return;
+            }
+            catch (const sort_cancelled&)
+            { }
+            catch (const std::exception& e)
+            { std::clog << racer.name << ": " << e.what() << std::endl; }
+
+            racer.finish = clock_type::now();
+            racer.perf.stop();
+            racer.state  = RaceState::CANCELLED;
+        }
+
+    private:
+        std::vector<std::unique_ptr<Racer>>     m_racers;
+        std::vector<Elements::element_type>     m_input;
+        std::unique_ptr<barrier_type>           m_ready;
+        std::atomic<time_point_type>            m_start;
+        size_type                               m_columns;
+        size_type                               m_rows;
+        float                                   m_tile_width;
+        float                                   m_tile_height;
+
+    };  /// class Race
+
+}  /// namespace sv
+
+#endif  // SV_RACE
@@ -0,0 +1,198 @@
+#ifndef SV_RACE_BOARD
+#   define SV_RACE_BOARD
+
+#include <SFML/Graphics.hpp>
+
+#include <sv/inputs.hxx>
+#include <sv/pacer.hxx>
+#include <sv/perf.hxx>
+#include <sv/race.hxx>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <source_location>
+#include <sstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+using namespace std::literals;
+
+namespace sv
+{
+    /// The statusbar of a race: the standings so far, with each racer's
+    /// time, operation counts and CPU counters, plus the race's key map.
+    /// Also captions every tile with its algorithm and place.
+    class RaceBoard : public sf::Sprite
+    {
+    public:
+        using float_type        = float;
+        using size_type         = unsigned int;
+        using texture_type      = sf::RenderTexture;
+        using font_type         = sf::Font;
+        using text_type         = sf::Text;
+
+    public:
+
+        RaceBoard(
+            float_type width,
+            float_type height,
+            size_type font_size,
+            std::shared_ptr<Race> race
+        ) noexcept
+            : m_width{ width }
+            , m_height{ height }
+            , m_font_size{ font_size }
+            , m_texture{ texture_type{} }
+            , m_font{ font_type{} }
+            , m_text{ text_type{} }
+            , m_caption{ text_type{} }
+            , m_race{ race }
+            , m_shape{ InputShape::RANDOM }
+            , m_seed{ 0uL }
+        {
+            m_texture.create(static_cast<unsigned int>(m_width), static_cast<unsigned int>(m_height));
+            this->setTexture(m_texture.getTexture());
+
+            auto srcloc         = std::source_location::current();
+            auto src_path       = fs::path(srcloc.file_name());
+            auto asset_path     = src_path.remove_filename() / "../../assets"s;
+
+            if (!m_font.loadFromFile(asset_path / "JetBrainsMonoNF.ttf"s))
+                std::clog << "Error loading font!" << std::endl;
+
+            m_text.setFont(m_font);
+            m_text.setCharacterSize(m_font_size);
+            m_caption.setFont(m_font);
+            m_caption.setCharacterSize(m_font_size);
+        }
+
+        /// The input the racers were dealt, for the header.
+        auto input(InputShape shape, std::uint64_t seed) noexcept
+            -> void
+        {
+            m_shape = shape;
+            m_seed  = seed;
+        }
+
+        auto render() noexcept -> void
+        {
+            auto ss         = std::stringstream{};
+            auto standings  { m_race->standings() };
+            const auto& racers = m_race->racers();
+
+            ss << "Race:\n"
+               << " Input: " << shape_name(m_shape) << ", seed " << m_seed << "\n"
+               << " Data size: " << (racers.empty() ? 0uL : racers.front()->elems->size()) << "\n"
+               << " Speed: " << _M_speed() << "\n"
+               << " Racing?: " << (m_race->running() ? "Yes" : "No") << "\n"
+               << " Paused?: " << (m_race->paused() ? "Yes" : "No") << "\n"
+               << "-------------------------------------------\n"
+               << "Standings:\n";
+
+            for (auto i { 0uL }; i < standings.size(); ++i)
+            {
+                const auto& st = standings[i];
+
+                ss << " " << _S_place(st) << " " << st.name << "\n"
+                   << "    " << std::fixed << std::setprecision(3)
+                   << std::chrono::duration<double>(st.elapsed).count() << " s"
+                   << (st.state == RaceState::FINISHED && !st.sorted ? " (NOT SORTED)" : "") << "\n"
+                   << "    Ops: " << st.operations() << " (cmps " << st.comparisons << ", swaps " << st.swaps << ")\n";
+
+                if (st.counters.has(PerfEvent::CYCLES))
+                    ss << "    Cycles: " << st.counters[PerfEvent::CYCLES]
+                       << " (IPC " << std::setprecision(2) << st.counters.ipc() << ")\n";
+                else if (st.counters.has(PerfEvent::CPU_TIME))
+                    ss << "    CPU time: " << std::setprecision(3)
+                       << static_cast<double>(st.counters[PerfEvent::CPU_TIME]) / 1e6 << " ms\n";
+
+                ss << std::defaultfloat << std::setprecision(6);
+            }
+
+            ss << "-------------------------------------------\n"
+               << "Key map:\n"
+               << "  Start / Restart: Enter\n"
+               << "  New Input: Space\n"
+               << "  Cancel Race: X\n"
+               << "  Pause/Resume: Tab\n"
+               << "  Speed Adjustment (ops/s):\n"
+               << "    x2 / /2: Up / Down Arrow\n"
+               << "    x10 / /10: Right / Left Arrow\n"
+               << "    Frame Lock: F\n"
+               << "  Exit: Esc\n";
+
+            m_text.setString(ss.str());
+
+            m_texture.clear();
+            m_texture.draw(m_text);
+            m_texture.display();
+        }
+
+        /// Draws each racer's name and place over the top left of its tile.
+        auto draw_captions(sf::RenderTarget& target) noexcept
+            -> void
+        {
+            for (const auto& st : m_race->standings())
+            {
+                auto tile { m_race->tile(st.racer) };
+                auto caption { st.name };
+
+                if (st.place != 0uL)
+                    caption = "#"s + std::to_string(st.place) + " "s + caption;
+
+                m_caption.setString(caption);
+                m_caption.setPosition(tile.left + 4.0f, tile.top + 2.0f);
+                target.draw(m_caption);
+            }
+        }
+
+    private:
+
+        static auto _S_place(const Standing& st)
+            -> std::string
+        {
+            switch (st.state)
+            {
+                case RaceState::FINISHED:   return "#"s + std::to_string(st.place);
+                case RaceState::RUNNING:    return "..";
+                case RaceState::CANCELLED:  return "DNF";
+                default:                    return "-";
+            }
+        }
+
+        auto _M_speed() const
+            -> std::string
+        {
+            const auto& pacer = m_race->pacer();
+
+            if (!pacer.throttled())
+                return "unthrottled"s;
+
+            auto ss = std::stringstream{};
+            ss << static_cast<std::size_t>(pacer.rate()) << " ops/s"
+               << (pacer.mode() == Pacer::Mode::FRAME ? " (frame locked)" : "");
+            return ss.str();
+        }
+
+    private:
+
+        float_type                  m_width;
+        float_type                  m_height;
+        size_type                   m_font_size;
+        texture_type                m_texture;
+        font_type                   m_font;
+        text_type                   m_text;
+        text_type                   m_caption;
+        std::shared_ptr<Race>       m_race;
+        InputShape                  m_shape;
+        std::uint64_t               m_seed;
+
+    };  /// class RaceBoard
+}
+
+#endif  // SV_RACE_BOARD
@@ -0,0 +1,304 @@
+#ifndef SV_REGISTRY
+#   define SV_REGISTRY
+
+#include <algorithms/bubblesort.hxx>
+#include <algorithms/bubblesortII.hxx>
+#include <algorithms/bucketsort.hxx>
+#include <algorithms/countingsort.hxx>
+#include <algorithms/external_mergesort.hxx>
+#include <algorithms/heapsort.hxx>
+#include <algorithms/insertionsort.hxx>
+#include <algorithms/introsort.hxx>
+#include <algorithms/mergesort.hxx>
+#include <algorithms/pancakesort.hxx>
+#include <algorithms/parallel_introsort.hxx>
+#include <algorithms/parallel_mergesort.hxx>
+#include <algorithms/parallel_quicksort.hxx>
+#include <algorithms/quicksort.hxx>
+#include <algorithms/radixsort.hxx>
+#include <algorithms/selectionsort.hxx>
+#include <algorithms/shellsort.hxx>
+#include <algorithms/timsort.hxx>
+#include <algorithms/vectorized_bucketsort.hxx>
+#include <algorithms/vectorized_introsort.hxx>
+#include <algorithms/vectorized_timsort.hxx>
+
+#include <sv/access.hxx>
+#include <sv/sorter.hxx>
+
+#include <span>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace std::literals;
+
+namespace sv
+{
+    /// The algorithms shipped with SV. Shared by the visualizer and
+    /// the headless benchmark so both always see the same registry.
+    inline auto default_algorithms()
+        -> Sorter::map_type
+    {
+        return Sorter::map_type{
+            { "Bubble Sort"s, std::tuple{
+                    "B"s,
+                    std::vector{ 
+                        " Time Complexity: O(n^2)"s,
+                        " Read & Swap: Red"s 
+                    },
+                    &instrumented<algorithms::bubblesort>
+            }},
+            { "Bubble Sort II"s, std::tuple{ 
+                    "Alt + B"s,
+                    std::vector{
+                        " Time Complexity (Worst): O(n^2)"s,
+                        " Time Complexity (Best): O(n)"s,
+                        " Reading: Red"s,
+                        " Writing: Blue"s
+                    },
+                    &instrumented<algorithms::bubblesortII>
+            }},
+            { "Bucket Sort"s, std::tuple{ 
+                    "Shift + B"s,
+                    std::vector{
+                        " Time Complexity: O(n + k)"s,
+                        " Find Minimum: Yellow"s,
+                        " Find Maximum: Cyan"s,
+                        " Reading: Red"s,
+                        " Writing: Blue"s
+                    },
+                    &instrumented<algorithms::bucketsort>
+            }},
+            { "Counting Sort"s, std::tuple{ 
+                    "Shift + C"s,
+                    std::vector{
+                        " Time Complexity: O(n^2)"s,
+                        " Find Minimum: Yellow"s,
+                        " Find Maximum: Cyan"s,
+                        " Reading: Red"s,
+                        " Writing: Blue"s
+                    },
+                    &instrumented<algorithms::countingsort>
+            }},
+            { "External Mergesort"s, std::tuple{ 
+                    "Alt + M"s,
+                    std::vector{
+                        " Time Complexity: O(nlog(n))"s,
+                        " Run Formation: Red"s,
+                        " Sorted Runs: Cyan & Magenta"s,
+                        " Merge Frontier: Green"s,
+                        " Block Write: Blue"s
+                    },
+                    &instrumented<algorithms::external_mergesort>
+            }},
+            { "Heapsort"s, std::tuple{ 
+                    "H"s,
+                    std::vector{
+                        " Time Complexity: O(nlog(n))"s,
+                        " Heap Levels: Random Colors"s,
+                        " Swapping: Magenta"s
+                    },
+                    &instrumented<algorithms::heapsort>
+            }},
+            { "Insertion Sort"s, std::tuple{ 
+                    "I"s,
+                    std::vector{
+                        " Time Complexity: O(n^2)"s,
+                        " Reading: Red"s,
+                        " Writing: Blue"s
+                    },
+                    &instrumented<algorithms::insertionsort>
+            }},
+            { "Introsort"s, std::tuple{ 
+                    "Shift + I"s,
+                    std::vector{
+                        " Time Complexity: O(nlog(n))"s,
+                        " Quick Reading: Red"s,
+                        " Quick Swapping: Blue"s,
+                        " Quick Pivot: Green"s,
+                        " Insertion Reading: Yellow"s,
+                        " Insertion Writing: Cyan"s,
+                        " Heap Levels: Random Colors"s,
+                        " Heap Swapping: Magenta"s
+                    },
+                    &instrumented<algorithms::introsort>
+            }},
+            { "Mergesort"s, std::tuple{ 
+                    "M"s,
+                    std::vector{ 
+                        " Time Complexity: O(nlog(n))"s,
+                        " Reading: Red"s,
+                        " Writing: Blue"s,
+                        " Left Bound: Cyan"s,
+                        " Right Bound: Yellow"s
+                    },
+                    &instrumented<algorithms::mergesort>
+            }},
+            { "Pancake Sort"s, std::tuple{ 
+                    "P"s,
+                    std::vector{
+                        " Time Complexity: O(n^2)"s,
+                        " Reverse Swap: Blue"s,
+                        " Finding Minimum: Yellow"s
+                    },
+                    &instrumented<algorithms::pancakesort>
+            }},
+            { "Parallel Introsort"s, std::tuple{ 
+                    "Alt + I"s,
+                    std::vector{
+                        " Time Complexity: O(nlog(n)/p)"s,
+                        " Work-stealing pool, one colour"s,
+                        " per worker owning a partition"s,
+                        " Reading: Red"s,
+                        " Heap Swapping: Magenta"s
+                    },
+                    &instrumented<algorithms::parallel_introsort>
+            }},
+            { "Parallel Mergesort"s, std::tuple{ 
+                    "Shift + M"s,
+                    std::vector{
+                        " Time Complexity: O(nlog(n)/p)"s,
+                        " Work-stealing pool, one colour"s,
+                        " per worker owning a run or"s,
+                        " merge chunk"s
+                    },
+                    &instrumented<algorithms::parallel_mergesort>
+            }},
+            { "Parallel Quicksort"s, std::tuple{ 
+                    "Shift + Q"s,
+                    std::vector{
+                        " Time Complexity: O(nlog(n)/p)"s,
+                        " Work-stealing pool, one colour"s,
+                        " per worker owning a partition"s,
+                        " Reading: Red"s
+                    },
+                    &instrumented<algorithms::parallel_quicksort>
+            }},
+            { "Quicksort"s, std::tuple{ 
+                    "Q"s,
+                    std::vector{
+                        " Time Complexity: O(nlog(n))"s,
+                        " Reading: Red"s,
+                        " Swapping: Blue"s,
+                        " Pivot: Green"s
+                    },
+                    &instrumented<algorithms::quicksort>
+            }},
+            { "Radix Sort"s, std::tuple{ 
+                    "R"s,
+                    std::vector{
+                        " Time Complexity: O(d*(n + b))"s,
+                        " Histograms: Yellow"s,
+                        " Scatter Read: Red"s,
+                        " Writing: Blue"s
+                    },
+                    &instrumented<algorithms::radixsort>
+            }},
+            { "Selection Sort"s, std::tuple{ 
+                    "S"s,
+                    std::vector{
+                        " Time Complexity: O(n^2)"s,
+                        " Writing: Blue"s,
+                        " Finding Minimum: Yellow"s
+                    },
+                    &instrumented<algorithms::selectionsort>
+            }},
+            { "Shell Sort"s, std::tuple{ 
+                    "Shift + S"s,
+                    std::vector{
+                        " Time Complexity: O(n^2)"s,
+                        " Reading: Red"s,
+                        " Writing: Blue"s
+                    },
+                    &instrumented<algorithms::shellsort>
+            }},
+            { "Timsort"s, std::tuple{ 
+                    "T"s,
+                    std::vector{
+                        " Time Complexity: O(nlog(n))"s,
+                        " Reading: Red"s,
+                        " Writing: Blue"s,
+                        " Left Bound: Cyan"s,
+                        " Right Bound: Yellow"s,
+                        " Subarray Insertion Start: Magenta"s
+                    },
+                    &instrumented<algorithms::timsort>
+            }},
+            { "Vectorized Bucket Sort"s, std::tuple{ 
+                    "Ctrl + B"s,
+                    std::vector{
+                        " Time Complexity: O(n + k)"s,
+                        " Fused Min & Max Scan: Yellow"s,
+                        " Bucketing: Red"s,
+                        " Bucket Write: Blue"s
+                    },
+                    &instrumented<algorithms::vectorized_bucketsort>
+            }},
+            { "Vectorized Introsort"s, std::tuple{ 
+                    "Ctrl + I"s,
+                    std::vector{
+                        " Time Complexity: O(nlog(n))"s,
+                        " Partition Block: Red"s,
+                        " Below Pivot: Blue"s,
+                        " Above Pivot: Magenta"s,
+                        " Sorting Network: Cyan"s
+                    },
+                    &instrumented<algorithms::vectorized_introsort>
+            }},
+            { "Vectorized Timsort"s, std::tuple{ 
+                    "Ctrl + T"s,
+                    std::vector{
+                        " Time Complexity: O(nlog(n))"s,
+                        " Sorting Network: Cyan"s,
+                        " Left Run: Cyan"s,
+                        " Right Run: Yellow"s,
+                        " Merge Write: Blue"s
+                    },
+                    &instrumented<algorithms::vectorized_timsort>
+            }}
+        };
+    }
+
+    template<access_policy A>
+    using native_function_type  = void (*)(A&);
+
+    template<access_policy A>
+    using native_map_type       = std::unordered_map<std::string, native_function_type<A>>;
+
+    /// The same algorithms compiled over an uninstrumented policy, eg.
+    /// `NativeAccess<T>` or `SoaAccess<K, P>`: no counters, marks or
+    /// pacing, just the algorithm on plain arrays of that element type.
+    template<access_policy A>
+    inline auto native_algorithms()
+        -> native_map_type<A>
+    {
+        return native_map_type<A>{
+            { "Bubble Sort"s,              &algorithms::bubblesort<A> },
+            { "Bubble Sort II"s,           &algorithms::bubblesortII<A> },
+            { "Bucket Sort"s,              &algorithms::bucketsort<A> },
+            { "Counting Sort"s,            &algorithms::countingsort<A> },
+            { "External Mergesort"s,       &algorithms::external_mergesort<A> },
+            { "Heapsort"s,                 &algorithms::heapsort<A> },
+            { "Insertion Sort"s,           &algorithms::insertionsort<A> },
+            { "Introsort"s,                &algorithms::introsort<A> },
+            { "Mergesort"s,                &algorithms::mergesort<A> },
+            { "Pancake Sort"s,             &algorithms::pancakesort<A> },
+            { "Parallel Introsort"s,       &algorithms::parallel_introsort<A> },
+            { "Parallel Mergesort"s,       &algorithms::parallel_mergesort<A> },
+            { "Parallel Quicksort"s,       &algorithms::parallel_quicksort<A> },
+            { "Quicksort"s,                &algorithms::quicksort<A> },
+            { "Radix Sort"s,               &algorithms::radixsort<A> },
+            { "Selection Sort"s,           &algorithms::selectionsort<A> },
+            { "Shell Sort"s,               &algorithms::shellsort<A> },
+            { "Timsort"s,                  &algorithms::timsort<A> },
+            { "Vectorized Bucket Sort"s,   &algorithms::vectorized_bucketsort<A> },
+            { "Vectorized Introsort"s,     &algorithms::vectorized_introsort<A> },
+            { "Vectorized Timsort"s,       &algorithms::vectorized_timsort<A> }
+        };
+    }
+
+}  /// namespace sv
+
+#endif  // SV_REGISTRY
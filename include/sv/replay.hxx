@@ -0,0 +1,267 @@
+#ifndef SV_REPLAY
+#   define SV_REPLAY
+
+#include <sv/elements.hxx>
+#include <sv/trace.hxx>
+#include <sv/viewer.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace sv
+{
+    /// Drives an `Elements`/`Viewer` pair from a recorded trace. Runs on
+    /// the render thread; seeking restores the closest keyframe and
+    /// decodes forward so any step costs at most one keyframe interval.
+    /// Auxiliary accesses only move the counters; the auxiliary lane is
+    /// not recorded and stays blank.
+    class Replayer
+    {
+    public:
+
+        using size_type         = std::size_t;
+        using step_type         = std::uint64_t;
+        using seconds_type      = std::chrono::duration<double>;
+
+    public:
+
+        explicit Replayer(
+            const fs::path& path,
+            std::shared_ptr<Elements> elems,
+            std::shared_ptr<Viewer> viewer
+        )
+            : m_reader{ path }
+            , m_elems{ elems }
+            , m_viewer{ viewer }
+            , m_cursor{ }
+            , m_counters{ }
+            , m_events{ m_reader.events() }
+            , m_rate{ std::max(1.0, static_cast<double>(m_reader.events()) / 30.0) }
+            , m_budget{ 0.0 }
+            , m_forward{ true }
+            , m_paused{ false }
+        {
+            if (m_elems->size() != m_reader.size())
+            {
+                m_elems->resize(m_reader.size());
+                m_viewer->resize(m_reader.size());
+            }
+
+            seek(step_type{});
+        }
+
+        auto path() const noexcept
+            -> const fs::path&
+        { return m_reader.path(); }
+
+        auto position() const noexcept
+            -> step_type
+        { return m_cursor.event; }
+
+        auto events() const noexcept
+            -> step_type
+        { return m_events; }
+
+        auto rate() const noexcept
+            -> double
+        { return m_rate; }
+
+        auto forward() const noexcept
+            -> bool
+        { return m_forward; }
+
+        auto paused() const noexcept
+            -> bool
+        { return m_paused; }
+
+        auto seek(step_type step)
+            -> void
+        {
+            step = std::min(step, m_events);
+
+            auto kf { m_reader.keyframe_before(step) };
+            m_cursor = m_reader.load(kf, m_elems->items(), m_viewer->colours(), m_counters);
+            m_viewer->touch_all();
+
+            _M_apply_until(step);
+        }
+
+        /// Moves `n` events forwards, or backwards for negative `n`.
+        auto step(long long n)
+            -> void
+        {
+            if (n >= 0LL)
+                _M_apply_until(m_cursor.event + static_cast<step_type>(n));
+            else
+                seek(m_cursor.event - std::min(m_cursor.event, static_cast<step_type>(-n)));
+        }
+
+        /// Plays `dt` worth of events at the current rate and direction.
+        auto advance(seconds_type dt)
+            -> void
+        {
+            if (m_paused)
+                return;
+
+            m_budget += m_rate * dt.count();
+            auto whole { std::floor(m_budget) };
+            m_budget -= whole;
+
+            auto n { static_cast<long long>(whole) };
+            step(m_forward ? n : -n);
+
+            if ((m_forward && m_cursor.event == events()) || (!m_forward && m_cursor.event == step_type{}))
+                m_paused = true;
+        }
+
+        auto toggle_pause() noexcept
+            -> void
+        {
+            m_paused ^= true;
+            m_budget = 0.0;
+        }
+
+        auto reverse() noexcept
+            -> void
+        { m_forward ^= true; }
+
+        /// Scales the playback rate (events per second).
+        auto scale_rate(double factor) noexcept
+            -> void
+        { m_rate = std::clamp(m_rate * factor, 1.0, 1e9); }
+
+    private:
+
+        auto _M_apply_until(step_type step)
+            -> void
+        {
+            auto& items     = m_elems->items();
+            auto& colours   = m_viewer->colours();
+            auto N          { items.size() };
+            auto event      = TraceEvent{};
+
+            auto fill = [&](size_type first, size_type last, sf::Color colour)
+            {
+                last = std::min(last, N);
+                if (first < last)
+                {
+                    colours.fill(first, last, colour);
+                    m_viewer->touch_range(first, last);
+                }
+            };
+
+            while (m_cursor.event < std::min(step, m_events) && _M_next(event))
+            {
+                auto& [cmps, reads, writes, swaps] = m_counters;
+
+                switch (event.op)
+                {
+                    case TraceOp::READ:
+                        reads += 1uL;
+                        break;
+
+                    case TraceOp::WRITE:
+                        writes += 1uL;
+                        if (event.first < N)
+                            items[event.first] = event.value;
+                        m_viewer->touch(event.first);
+                        break;
+
+                    case TraceOp::COMPARE:
+                        cmps += 1uL;
+                        reads += 2uL;
+                        break;
+
+                    case TraceOp::AUX_READ:
+                        reads += event.first;
+                        break;
+
+                    case TraceOp::AUX_WRITE:
+                        writes += event.first;
+                        break;
+
+                    case TraceOp::COMPARISONS:
+                        cmps += event.first;
+                        break;
+
+                    case TraceOp::SWAP:
+                        swaps += 1uL;
+                        reads += 2uL;
+                        writes += 2uL;
+                        if (event.first < N && event.second < N)
+                            std::swap(items[event.first], items[event.second]);
+                        m_viewer->touch(event.first);
+                        m_viewer->touch(event.second);
+                        break;
+
+                    case TraceOp::MARK:
+                        if (event.first < N)
+                            colours.store(event.first, event.colour);
+                        m_viewer->touch(event.first);
+                        break;
+
+                    case TraceOp::UNMARK:
+                        if (event.first < N)
+                            colours.store(event.first, sf::Color::White);
+                        m_viewer->touch(event.first);
+                        break;
+
+                    case TraceOp::MARK_RANGE:
+                        fill(event.first, event.second, event.colour);
+                        break;
+
+                    case TraceOp::UNMARK_RANGE:
+                        fill(event.first, event.second, sf::Color::White);
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+
+            m_elems->set_counters(m_counters.at(0), m_counters.at(1), m_counters.at(2), m_counters.at(3));
+        }
+
+        /// Decodes the next event. A damaged one ends the trace there,
+        /// so everything recorded before it still plays.
+        auto _M_next(TraceEvent& event)
+            -> bool
+        {
+            try
+            {
+                return m_reader.next(m_cursor, event);
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::clog << e.what() << std::endl;
+                m_events = m_cursor.event;
+                m_paused = true;
+                return false;
+            }
+        }
+
+    private:
+        TraceReader                     m_reader;
+        std::shared_ptr<Elements>       m_elems;
+        std::shared_ptr<Viewer>         m_viewer;
+        TraceReader::Cursor             m_cursor;
+        TraceReader::counters_type      m_counters;
+        step_type                       m_events;
+        double                          m_rate;
+        double                          m_budget;
+        bool                            m_forward;
+        bool                            m_paused;
+
+    };  /// class Replayer
+
+}  /// namespace sv
+
+#endif  // SV_REPLAY
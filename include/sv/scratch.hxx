@@ -0,0 +1,373 @@
+#ifndef SV_SCRATCH
+#   define SV_SCRATCH
+
+#include <sv/dirty.hxx>
+#include <sv/thread_pool.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sv
+{
+    /// Auxiliary memory for the out-of-place algorithms. Every thread that
+    /// sorts (the caller plus each pool worker) bumps through a stack of
+    /// blocks of its own and a `Lease` hands its region back when it goes
+    /// out of scope. Blocks are kept, so once a sort has run at a size
+    /// every later sort at that size is served without touching the heap.
+    ///
+    /// A thread claims an arena with its first lease and gives it back
+    /// with its last, so arenas are keyed by thread rather than by pool
+    /// slot. Leases must be released in the reverse order they were taken
+    /// on a thread, which scoped leases do naturally.
+    ///
+    /// Every arena counts its offsets from zero, so only leases from
+    /// arena 0, which the caller claims first, are drawn on the auxiliary
+    /// lane; the workers' would land on each other's slots.
+    class Scratch
+    {
+    public:
+
+        using size_type     = std::size_t;
+        using lane_type     = float;
+        using dirty_type    = std::shared_ptr<DirtyBars>;
+
+        /// Bytes currently and at most leased since the last reset, bytes
+        /// held in blocks, and the block allocations and leases made.
+        struct Stats
+        {
+            size_type   in_use;
+            size_type   peak;
+            size_type   reserved;
+            size_type   allocations;
+            size_type   leases;
+        };
+
+    private:
+
+        struct Position
+        {
+            size_type   block   { 0uL };
+            size_type   top     { 0uL };
+            size_type   base    { 0uL };
+        };
+
+        struct Arena
+        {
+            std::vector<std::unique_ptr<std::byte[]>>   blocks;
+            std::vector<size_type>                      sizes;
+            Position                                    position;
+            std::atomic<std::thread::id>                owner;
+        };
+
+    public:
+
+        /// `count` uninitialised `T`s. Moving a lease transfers the
+        /// region; the moved-from lease is empty.
+        template<typename T>
+        class Lease
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+
+        public:
+
+            using value_type    = T;
+            using size_type     = Scratch::size_type;
+
+        public:
+
+            Lease() noexcept = default;
+
+            Lease(Lease&& other) noexcept
+                : m_owner{ std::exchange(other.m_owner, nullptr) }
+                , m_arena{ other.m_arena }
+                , m_data{ std::exchange(other.m_data, nullptr) }
+                , m_size{ std::exchange(other.m_size, 0uL) }
+                , m_offset{ other.m_offset }
+                , m_restore{ other.m_restore }
+                , m_lane{ other.m_lane }
+            { }
+
+            Lease(const Lease&) = delete;
+            auto operator= (const Lease&) -> Lease& = delete;
+            auto operator= (Lease&&) -> Lease& = delete;
+
+            ~Lease() noexcept
+            {
+                if (m_owner)
+                    m_owner->_M_release(*m_arena, m_restore, m_size * sizeof(T), m_lane ? m_offset : 0uL, m_lane ? m_size : 0uL);
+            }
+
+            auto size() const noexcept
+                -> size_type
+            { return m_size; }
+
+            auto data() const noexcept
+                -> T*
+            { return m_data; }
+
+            auto span() const noexcept
+                -> std::span<T>
+            { return { m_data, m_size }; }
+
+            /// Where the lease starts in its arena, in `T`s; used to place
+            /// it on the auxiliary lane.
+            auto offset() const noexcept
+                -> size_type
+            { return m_offset; }
+
+            /// Whether the lease shows on the auxiliary lane.
+            auto drawn() const noexcept
+                -> bool
+            { return m_lane; }
+
+            auto operator[] (size_type idx) const noexcept
+                -> T&
+            { return m_data[idx]; }
+
+            auto read(size_type idx) const noexcept
+                -> T
+            { return m_data[idx]; }
+
+            auto write(size_type idx, T value) const noexcept
+                -> void
+            { m_data[idx] = value; }
+
+            template<typename C>
+            auto mark([[maybe_unused]] size_type idx, [[maybe_unused]] C colour) const noexcept
+                -> void
+            { }
+
+            auto unmark([[maybe_unused]] size_type idx) const noexcept
+                -> void
+            { }
+
+            template<typename C>
+            auto mark_range([[maybe_unused]] size_type fidx, [[maybe_unused]] size_type eidx, [[maybe_unused]] C colour) const noexcept
+                -> void
+            { }
+
+        private:
+
+            friend class Scratch;
+
+            Scratch*    m_owner     { nullptr };
+            Arena*      m_arena     { nullptr };
+            T*          m_data      { nullptr };
+            size_type   m_size      { 0uL };
+            size_type   m_offset    { 0uL };
+            Position    m_restore   { };
+            bool        m_lane      { false };
+
+        };  /// class Lease
+
+    public:
+
+        /// `lane` is how many slots the auxiliary lane mirrors; leases
+        /// past it are still served but not drawn.
+        explicit Scratch(size_type lane = 0uL)
+            : m_arenas(parallel::pool().size() + s_spare)
+            , m_lane(lane)
+        { }
+
+        Scratch(const Scratch&) = delete;
+        auto operator= (const Scratch&) -> Scratch& = delete;
+
+        /// Leases `count` `T`s from the calling thread's arena. With
+        /// `lane` set a lease from the caller's arena is drawn, and
+        /// cleared off the auxiliary lane again on release.
+        template<typename T>
+        auto lease(size_type count, bool lane = false)
+            -> Lease<T>
+        {
+            auto lease = Lease<T>{};
+
+            if (count == 0uL)
+                return lease;
+
+            auto& arena { _M_arena() };
+            auto bytes  { count * sizeof(T) };
+            auto& pos   { arena.position };
+
+            lease.m_restore = pos;
+
+            auto align = [](size_type top) { return (top + alignof(T) - 1uL) / alignof(T) * alignof(T); };
+
+            while (pos.block < arena.blocks.size() && align(pos.top) + bytes > arena.sizes[pos.block])
+            {
+                pos.base += arena.sizes[pos.block];
+                pos.block += 1uL;
+                pos.top = 0uL;
+            }
+
+            /// New blocks double the last one, but no further than a few
+            /// times the request so a small table leased after a large
+            /// buffer doesn't reserve twice the buffer again.
+            if (pos.block == arena.blocks.size())
+            {
+                auto grown { arena.sizes.empty() ? 0uL : std::min(2uL * arena.sizes.back(), 4uL * bytes) };
+                auto size  { std::max({ bytes, s_min_block, grown }) };
+
+                arena.blocks.push_back(std::make_unique_for_overwrite<std::byte[]>(size));
+                arena.sizes.push_back(size);
+                m_allocations.fetch_add(1uL, std::memory_order_relaxed);
+                m_reserved.fetch_add(size, std::memory_order_relaxed);
+            }
+
+            pos.top = align(pos.top);
+
+            lease.m_owner   = this;
+            lease.m_arena   = &arena;
+            lease.m_data    = reinterpret_cast<T*>(arena.blocks[pos.block].get() + pos.top);
+            lease.m_size    = count;
+            lease.m_offset  = (pos.base + pos.top) / sizeof(T);
+            lease.m_lane    = lane && &arena == &m_arenas.front();
+
+            pos.top += bytes;
+
+            m_leases.fetch_add(1uL, std::memory_order_relaxed);
+            auto in_use { m_in_use.fetch_add(bytes, std::memory_order_relaxed) + bytes };
+            auto peak   { m_peak.load(std::memory_order_relaxed) };
+
+            while (in_use > peak && !m_peak.compare_exchange_weak(peak, in_use, std::memory_order_relaxed))
+                ;
+
+            return lease;
+        }
+
+        auto stats() const noexcept
+            -> Stats
+        {
+            return Stats{
+                m_in_use.load(std::memory_order_relaxed),
+                m_peak.load(std::memory_order_relaxed),
+                m_reserved.load(std::memory_order_relaxed),
+                m_allocations.load(std::memory_order_relaxed),
+                m_leases.load(std::memory_order_relaxed)
+            };
+        }
+
+        /// Starts a new measurement; blocks already held are kept.
+        auto reset_stats() noexcept
+            -> void
+        {
+            m_peak.store(m_in_use.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            m_allocations.store(0uL, std::memory_order_relaxed);
+            m_leases.store(0uL, std::memory_order_relaxed);
+        }
+
+        /// Read by the render thread while the sort mirrors into it, so
+        /// slots are loaded and stored relaxed.
+        auto lane() const noexcept
+            -> const std::vector<std::atomic<lane_type>>&
+        { return m_lane; }
+
+        auto resize_lane(size_type lane)
+            -> void
+        {
+            m_lane = std::vector<std::atomic<lane_type>>(lane);
+
+            if (m_dirty)
+                m_dirty->touch_all();
+        }
+
+        /// Flags the lane slots drawing each mirrored value for redraw.
+        auto watch(dirty_type dirty) noexcept
+            -> void
+        { m_dirty = std::move(dirty); }
+
+        /// Shows `value` at slot `idx` of `lease` on the auxiliary lane,
+        /// if the lease is drawn.
+        template<typename T>
+        auto mirror(const Lease<T>& lease, size_type idx, lane_type value) noexcept
+            -> void
+        {
+            idx += lease.offset();
+
+            if (!lease.drawn() || idx >= m_lane.size())
+                return;
+
+            m_lane[idx].store(value, std::memory_order_relaxed);
+
+            if (m_dirty)
+                m_dirty->touch(idx);
+        }
+
+    private:
+
+        static constexpr auto s_min_block   { 64uL * 1024uL };
+        static constexpr auto s_spare       { 4uL };    /// arenas past one per worker, for threads outside the pool
+
+        /// The arena the calling thread holds, or a free one it claims.
+        /// Threads outside the pool look from arena 0 and pool workers
+        /// from the one past their index, so each usually finds its own
+        /// on the first try.
+        auto _M_arena()
+            -> Arena&
+        {
+            auto self   { std::this_thread::get_id() };
+            auto w      { parallel::ThreadPool::current() };
+            auto start  { w == parallel::ThreadPool::npos ? 0uL : (w + 1uL) % m_arenas.size() };
+            auto N      { m_arenas.size() };
+
+            for (auto k { 0uL }; k < N; ++k)
+                if (auto& arena { m_arenas[(start + k) % N] }; arena.owner.load(std::memory_order_relaxed) == self)
+                    return arena;
+
+            for (auto k { 0uL }; k < N; ++k)
+            {
+                auto& arena { m_arenas[(start + k) % N] };
+                auto none   = std::thread::id{};
+
+                if (arena.owner.compare_exchange_strong(none, self, std::memory_order_acquire, std::memory_order_relaxed))
+                    return arena;
+            }
+
+            throw std::runtime_error("More threads leasing scratch space at once than it has arenas.");
+        }
+
+        auto _M_release(Arena& arena, Position restore, size_type bytes, size_type offset, size_type lane) noexcept
+            -> void
+        {
+            arena.position = restore;
+            m_in_use.fetch_sub(bytes, std::memory_order_relaxed);
+
+            /// The thread's last lease; the arena is free for any other.
+            if (restore.block == 0uL && restore.top == 0uL)
+                arena.owner.store(std::thread::id{}, std::memory_order_release);
+
+            if (lane == 0uL || offset >= m_lane.size())
+                return;
+
+            auto last { std::min(offset + lane, m_lane.size()) };
+
+            for (auto i { offset }; i < last; ++i)
+                m_lane[i].store(lane_type{}, std::memory_order_relaxed);
+
+            if (m_dirty)
+                m_dirty->touch_range(offset, last);
+        }
+
+    private:
+        std::vector<Arena>          m_arenas;
+        std::vector<std::atomic<lane_type>> m_lane;
+        dirty_type                  m_dirty         { nullptr };
+
+        std::atomic<size_type>      m_in_use        { 0uL };
+        std::atomic<size_type>      m_peak          { 0uL };
+        std::atomic<size_type>      m_reserved      { 0uL };
+        std::atomic<size_type>      m_allocations   { 0uL };
+        std::atomic<size_type>      m_leases        { 0uL };
+
+    };  /// class Scratch
+
+}  /// namespace sv
+
+#endif  // SV_SCRATCH
@@ -0,0 +1,594 @@
+#ifndef SV_SIMD
+#   define SV_SIMD
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#   include <immintrin.h>
+#   define SV_SIMD_X86 1
+#else
+#   define SV_SIMD_X86 0
+#endif
+
+using namespace std::literals;
+
+/// Vector kernels for the hot base cases and scans. Every kernel has an
+/// AVX2, an SSE4.1 and a scalar body; which one runs is decided once at
+/// startup from the CPU, so the binary itself needs no `-m` flags.
+namespace sv::simd
+{
+    enum class Isa { SCALAR, SSE41, AVX2 };
+
+    /// Largest range `sort_network` sorts.
+    constexpr auto network_size { 64uL };
+
+    /// The best instruction set this CPU supports, capped by the
+    /// `SV_SIMD` environment variable (`scalar`, `sse4.1` or `avx2`)
+    /// so the paths can be compared on one machine.
+    inline auto isa() noexcept
+        -> Isa
+    {
+        static const auto level = []
+        {
+            auto best { Isa::SCALAR };
+
+#if SV_SIMD_X86
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx2"))
+                best = Isa::AVX2;
+            else if (__builtin_cpu_supports("sse4.1"))
+                best = Isa::SSE41;
+#endif
+
+            if (auto cap { std::getenv("SV_SIMD") }; cap)
+            {
+                if (cap == "scalar"sv)
+                    best = Isa::SCALAR;
+                else if (cap == "sse4.1"sv)
+                    best = std::min(best, Isa::SSE41);
+            }
+
+            return best;
+        }();
+
+        return level;
+    }
+
+    inline auto isa_name(Isa level = isa()) noexcept
+        -> std::string_view
+    {
+        switch (level)
+        {
+            case Isa::AVX2:     return "AVX2"sv;
+            case Isa::SSE41:    return "SSE4.1"sv;
+            default:            return "Scalar"sv;
+        }
+    }
+
+    /// Floats per vector register.
+    inline auto lanes(Isa level = isa()) noexcept
+        -> std::size_t
+    {
+        switch (level)
+        {
+            case Isa::AVX2:     return 8uL;
+            case Isa::SSE41:    return 4uL;
+            default:            return 1uL;
+        }
+    }
+
+    /// Compare-exchanges made by the bitonic network for `n` elements.
+    constexpr auto network_comparators(std::size_t n) noexcept
+        -> std::size_t
+    {
+        if (n < 2uL)
+            return 0uL;
+
+        auto p { std::bit_ceil(n) };
+        auto log { static_cast<std::size_t>(std::countr_zero(p)) };
+        return p / 2uL * log * (log + 1uL) / 2uL;
+    }
+
+    namespace detail
+    {
+        template<typename T>
+        constexpr auto _S_pad() noexcept
+            -> T
+        {
+            if constexpr (std::numeric_limits<T>::has_infinity)
+                return std::numeric_limits<T>::infinity();
+            else
+                return std::numeric_limits<T>::max();
+        }
+
+        template<typename T>
+        auto _S_bitonic_scalar(T* a, std::size_t p) noexcept
+            -> void
+        {
+            for (auto k { 2uL }; k <= p; k *= 2uL)
+                for (auto j { k / 2uL }; j > 0uL; j /= 2uL)
+                    for (auto i { 0uL }; i < p; ++i)
+                        if (auto l { i ^ j }; l > i)
+                        {
+                            auto up { (i & k) == 0uL };
+
+                            if (up ? a[l] < a[i] : a[i] < a[l])
+                                std::swap(a[i], a[l]);
+                        }
+        }
+
+        template<typename T>
+        auto _S_partition_scalar(const T* in, std::size_t n, T pivot, T* left, T* right, bool or_equal) noexcept
+            -> std::size_t
+        {
+            auto nl { 0uL };
+            auto nr { 0uL };
+
+            for (auto i { 0uL }; i < n; ++i)
+                if (in[i] < pivot || (or_equal && !(pivot < in[i])))
+                    left[nl++] = in[i];
+                else
+                    right[nr++] = in[i];
+
+            return nl;
+        }
+
+        template<typename T>
+        auto _S_minmax_scalar(const T* a, std::size_t n) noexcept
+            -> std::pair<T, T>
+        {
+            auto lo { a[0] };
+            auto hi { a[0] };
+
+            for (auto i { 1uL }; i < n; ++i)
+            {
+                lo = std::min(lo, a[i]);
+                hi = std::max(hi, a[i]);
+            }
+
+            return { lo, hi };
+        }
+
+        template<typename T>
+        auto _S_sorted_until_scalar(const T* a, std::size_t first, std::size_t n) noexcept
+            -> std::size_t
+        {
+            for (auto i { std::max(first, 1uL) }; i < n; ++i)
+                if (a[i] < a[i - 1uL])
+                    return i;
+
+            return n;
+        }
+
+        /// For each movemask value, the lanes whose bit is set followed
+        /// by the lanes whose bit is clear.
+        template<std::size_t L>
+        constexpr auto _S_compress_table() noexcept
+        {
+            auto table = std::array<std::array<std::uint32_t, L>, (1uL << L)>{};
+
+            for (auto m { 0uL }; m < (1uL << L); ++m)
+            {
+                auto k { 0uL };
+
+                for (auto l { 0uL }; l < L; ++l)
+                    if (m & (1uL << l))
+                        table[m][k++] = static_cast<std::uint32_t>(l);
+
+                for (auto l { 0uL }; l < L; ++l)
+                    if (!(m & (1uL << l)))
+                        table[m][k++] = static_cast<std::uint32_t>(l);
+            }
+
+            return table;
+        }
+
+#if SV_SIMD_X86
+        inline constexpr auto s_compress8 { _S_compress_table<8uL>() };
+
+        /// `_S_compress_table<4>` as `pshufb` byte indices.
+        inline constexpr auto s_compress4 = []
+        {
+            auto table = std::array<std::array<std::uint8_t, 16>, 16>{};
+
+            for (auto m { 0uL }; m < 16uL; ++m)
+                for (auto l { 0uL }; l < 4uL; ++l)
+                    for (auto b { 0uL }; b < 4uL; ++b)
+                        table[m][l * 4uL + b] = static_cast<std::uint8_t>(_S_compress_table<4uL>()[m][l] * 4u + b);
+
+            return table;
+        }();
+
+        /// Keeps the minimum of each pair in lanes that should hold the
+        /// smaller value (lower lane of an ascending pair or upper lane of
+        /// a descending one) and the maximum elsewhere.
+        __attribute__((target("avx2")))
+        inline auto _S_exchange_avx2(__m256 v, __m256 p, std::size_t i, std::size_t j, std::size_t k) noexcept
+            -> __m256
+        {
+            auto idx  = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(i)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            auto zero = _mm256_setzero_si256();
+            auto low  = _mm256_cmpeq_epi32(_mm256_and_si256(idx, _mm256_set1_epi32(static_cast<int>(j))), zero);
+            auto up   = _mm256_cmpeq_epi32(_mm256_and_si256(idx, _mm256_set1_epi32(static_cast<int>(k))), zero);
+            auto take = _mm256_castsi256_ps(_mm256_xor_si256(low, up));
+
+            return _mm256_blendv_ps(_mm256_min_ps(v, p), _mm256_max_ps(v, p), take);
+        }
+
+        __attribute__((target("avx2")))
+        inline auto _S_bitonic_avx2(float* a, std::size_t p) noexcept
+            -> void
+        {
+            for (auto k { 2uL }; k <= p; k *= 2uL)
+                for (auto j { k / 2uL }; j > 0uL; j /= 2uL)
+                {
+                    if (j >= 8uL)
+                    {
+                        for (auto base { 0uL }; base < p; base += 2uL * j)
+                            for (auto i { base }; i < base + j; i += 8uL)
+                            {
+                                auto lo = _mm256_load_ps(a + i);
+                                auto hi = _mm256_load_ps(a + i + j);
+                                auto mn = _mm256_min_ps(lo, hi);
+                                auto mx = _mm256_max_ps(lo, hi);
+                                auto up { (i & k) == 0uL };
+
+                                _mm256_store_ps(a + i,     up ? mn : mx);
+                                _mm256_store_ps(a + i + j, up ? mx : mn);
+                            }
+
+                        continue;
+                    }
+
+                    auto perm = _mm256_xor_si256(
+                        _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                        _mm256_set1_epi32(static_cast<int>(j))
+                    );
+
+                    for (auto i { 0uL }; i < p; i += 8uL)
+                    {
+                        auto v = _mm256_load_ps(a + i);
+                        _mm256_store_ps(a + i, _S_exchange_avx2(v, _mm256_permutevar8x32_ps(v, perm), i, j, k));
+                    }
+                }
+        }
+
+        __attribute__((target("sse4.1")))
+        inline auto _S_exchange_sse41(__m128 v, __m128 p, std::size_t i, std::size_t j, std::size_t k) noexcept
+            -> __m128
+        {
+            auto idx  = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(i)), _mm_setr_epi32(0, 1, 2, 3));
+            auto zero = _mm_setzero_si128();
+            auto low  = _mm_cmpeq_epi32(_mm_and_si128(idx, _mm_set1_epi32(static_cast<int>(j))), zero);
+            auto up   = _mm_cmpeq_epi32(_mm_and_si128(idx, _mm_set1_epi32(static_cast<int>(k))), zero);
+            auto take = _mm_castsi128_ps(_mm_xor_si128(low, up));
+
+            return _mm_blendv_ps(_mm_min_ps(v, p), _mm_max_ps(v, p), take);
+        }
+
+        __attribute__((target("sse4.1")))
+        inline auto _S_bitonic_sse41(float* a, std::size_t p) noexcept
+            -> void
+        {
+            for (auto k { 2uL }; k <= p; k *= 2uL)
+                for (auto j { k / 2uL }; j > 0uL; j /= 2uL)
+                {
+                    if (j >= 4uL)
+                    {
+                        for (auto base { 0uL }; base < p; base += 2uL * j)
+                            for (auto i { base }; i < base + j; i += 4uL)
+                            {
+                                auto lo = _mm_load_ps(a + i);
+                                auto hi = _mm_load_ps(a + i + j);
+                                auto mn = _mm_min_ps(lo, hi);
+                                auto mx = _mm_max_ps(lo, hi);
+                                auto up { (i & k) == 0uL };
+
+                                _mm_store_ps(a + i,     up ? mn : mx);
+                                _mm_store_ps(a + i + j, up ? mx : mn);
+                            }
+
+                        continue;
+                    }
+
+                    for (auto i { 0uL }; i < p; i += 4uL)
+                    {
+                        auto v = _mm_load_ps(a + i);
+                        auto s = j == 2uL
+                            ? _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2))
+                            : _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+
+                        _mm_store_ps(a + i, _S_exchange_sse41(v, s, i, j, k));
+                    }
+                }
+        }
+
+        __attribute__((target("avx2")))
+        inline auto _S_partition_avx2(const float* in, std::size_t n, float pivot, float* left, float* right, bool or_equal) noexcept
+            -> std::size_t
+        {
+            auto pv = _mm256_set1_ps(pivot);
+            auto nl { 0uL };
+            auto nr { 0uL };
+            auto i  { 0uL };
+
+            for (; i + 8uL <= n; i += 8uL)
+            {
+                auto v = _mm256_loadu_ps(in + i);
+                auto c = or_equal ? _mm256_cmp_ps(v, pv, _CMP_LE_OQ) : _mm256_cmp_ps(v, pv, _CMP_LT_OQ);
+                auto m { static_cast<unsigned>(_mm256_movemask_ps(c)) };
+                auto k { static_cast<std::size_t>(std::popcount(m)) };
+
+                auto l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s_compress8[m].data()));
+                auto r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s_compress8[~m & 0xFFu].data()));
+
+                _mm256_storeu_ps(left + nl,  _mm256_permutevar8x32_ps(v, l));
+                _mm256_storeu_ps(right + nr, _mm256_permutevar8x32_ps(v, r));
+
+                nl += k;
+                nr += 8uL - k;
+            }
+
+            return nl + _S_partition_scalar(in + i, n - i, pivot, left + nl, right + nr, or_equal);
+        }
+
+        __attribute__((target("sse4.1")))
+        inline auto _S_partition_sse41(const float* in, std::size_t n, float pivot, float* left, float* right, bool or_equal) noexcept
+            -> std::size_t
+        {
+            auto pv = _mm_set1_ps(pivot);
+            auto nl { 0uL };
+            auto nr { 0uL };
+            auto i  { 0uL };
+
+            for (; i + 4uL <= n; i += 4uL)
+            {
+                auto v = _mm_loadu_ps(in + i);
+                auto c = or_equal ? _mm_cmple_ps(v, pv) : _mm_cmplt_ps(v, pv);
+                auto m { static_cast<unsigned>(_mm_movemask_ps(c)) };
+                auto k { static_cast<std::size_t>(std::popcount(m)) };
+
+                auto l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_compress4[m].data()));
+                auto r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_compress4[~m & 0xFu].data()));
+
+                _mm_storeu_ps(left + nl,  _mm_castsi128_ps(_mm_shuffle_epi8(_mm_castps_si128(v), l)));
+                _mm_storeu_ps(right + nr, _mm_castsi128_ps(_mm_shuffle_epi8(_mm_castps_si128(v), r)));
+
+                nl += k;
+                nr += 4uL - k;
+            }
+
+            return nl + _S_partition_scalar(in + i, n - i, pivot, left + nl, right + nr, or_equal);
+        }
+
+        __attribute__((target("avx2")))
+        inline auto _S_minmax_avx2(const float* a, std::size_t n) noexcept
+            -> std::pair<float, float>
+        {
+            if (n < 8uL)
+                return _S_minmax_scalar(a, n);
+
+            auto lo = _mm256_loadu_ps(a);
+            auto hi = lo;
+            auto i  { 8uL };
+
+            for (; i + 8uL <= n; i += 8uL)
+            {
+                auto v = _mm256_loadu_ps(a + i);
+                lo = _mm256_min_ps(lo, v);
+                hi = _mm256_max_ps(hi, v);
+            }
+
+            /// The tail overlaps the last full vector, which is harmless
+            /// for min and max.
+            if (i < n)
+            {
+                auto v = _mm256_loadu_ps(a + n - 8uL);
+                lo = _mm256_min_ps(lo, v);
+                hi = _mm256_max_ps(hi, v);
+            }
+
+            alignas(32) auto l = std::array<float, 8>{};
+            alignas(32) auto h = std::array<float, 8>{};
+            _mm256_store_ps(l.data(), lo);
+            _mm256_store_ps(h.data(), hi);
+
+            return { *std::ranges::min_element(l), *std::ranges::max_element(h) };
+        }
+
+        __attribute__((target("sse4.1")))
+        inline auto _S_minmax_sse41(const float* a, std::size_t n) noexcept
+            -> std::pair<float, float>
+        {
+            if (n < 4uL)
+                return _S_minmax_scalar(a, n);
+
+            auto lo = _mm_loadu_ps(a);
+            auto hi = lo;
+            auto i  { 4uL };
+
+            for (; i + 4uL <= n; i += 4uL)
+            {
+                auto v = _mm_loadu_ps(a + i);
+                lo = _mm_min_ps(lo, v);
+                hi = _mm_max_ps(hi, v);
+            }
+
+            if (i < n)
+            {
+                auto v = _mm_loadu_ps(a + n - 4uL);
+                lo = _mm_min_ps(lo, v);
+                hi = _mm_max_ps(hi, v);
+            }
+
+            alignas(16) auto l = std::array<float, 4>{};
+            alignas(16) auto h = std::array<float, 4>{};
+            _mm_store_ps(l.data(), lo);
+            _mm_store_ps(h.data(), hi);
+
+            return { *std::ranges::min_element(l), *std::ranges::max_element(h) };
+        }
+
+        __attribute__((target("avx2")))
+        inline auto _S_sorted_until_avx2(const float* a, std::size_t n) noexcept
+            -> std::size_t
+        {
+            auto i { 0uL };
+
+            for (; i + 9uL <= n; i += 8uL)
+            {
+                auto c = _mm256_cmp_ps(_mm256_loadu_ps(a + i + 1uL), _mm256_loadu_ps(a + i), _CMP_LT_OQ);
+
+                if (auto m { static_cast<unsigned>(_mm256_movemask_ps(c)) }; m)
+                    return i + 1uL + static_cast<std::size_t>(std::countr_zero(m));
+            }
+
+            return _S_sorted_until_scalar(a, i, n);
+        }
+
+        __attribute__((target("sse4.1")))
+        inline auto _S_sorted_until_sse41(const float* a, std::size_t n) noexcept
+            -> std::size_t
+        {
+            auto i { 0uL };
+
+            for (; i + 5uL <= n; i += 4uL)
+            {
+                auto c = _mm_cmplt_ps(_mm_loadu_ps(a + i + 1uL), _mm_loadu_ps(a + i));
+
+                if (auto m { static_cast<unsigned>(_mm_movemask_ps(c)) }; m)
+                    return i + 1uL + static_cast<std::size_t>(std::countr_zero(m));
+            }
+
+            return _S_sorted_until_scalar(a, i, n);
+        }
+#endif
+    }  /// namespace detail
+
+    /// Sorts `n <= network_size` elements with a bitonic network, padding
+    /// up to a power of two (and at least one register) with `+inf`.
+    /// Records could tie with the padding and lose their payload, so they
+    /// are insertion sorted instead.
+    template<typename T>
+    auto sort_network(T* data, std::size_t n) noexcept
+        -> void
+    {
+        if (n < 2uL)
+            return;
+
+        if constexpr (!std::is_arithmetic_v<T>)
+        {
+            for (auto i { 1uL }; i < n; ++i)
+                for (auto j { i }; j > 0uL && data[j] < data[j - 1uL]; --j)
+                    std::swap(data[j], data[j - 1uL]);
+
+            return;
+        }
+
+        alignas(32) auto buffer = std::array<T, network_size>{};
+        auto p { std::bit_ceil(n) };
+
+        if constexpr (std::same_as<T, float>)
+            p = std::max(p, lanes());
+
+        std::copy_n(data, n, buffer.begin());
+        std::fill(buffer.begin() + n, buffer.begin() + p, detail::_S_pad<T>());
+
+        if constexpr (std::same_as<T, float>)
+        {
+#if SV_SIMD_X86
+            if (isa() == Isa::AVX2)
+            {
+                detail::_S_bitonic_avx2(buffer.data(), p);
+                std::copy_n(buffer.begin(), n, data);
+                return;
+            }
+
+            if (isa() == Isa::SSE41)
+            {
+                detail::_S_bitonic_sse41(buffer.data(), p);
+                std::copy_n(buffer.begin(), n, data);
+                return;
+            }
+#endif
+        }
+
+        detail::_S_bitonic_scalar(buffer.data(), p);
+        std::copy_n(buffer.begin(), n, data);
+    }
+
+    /// Splits `in` around `pivot`: elements less than (or, with
+    /// `or_equal`, not greater than) the pivot are packed into `left`,
+    /// the rest into `right`. Both outputs need `n + lanes()` slots.
+    /// Returns how many went left.
+    template<typename T>
+    auto partition(const T* in, std::size_t n, T pivot, T* left, T* right, bool or_equal = false) noexcept
+        -> std::size_t
+    {
+        if constexpr (std::same_as<T, float>)
+        {
+#if SV_SIMD_X86
+            if (isa() == Isa::AVX2)
+                return detail::_S_partition_avx2(in, n, pivot, left, right, or_equal);
+
+            if (isa() == Isa::SSE41)
+                return detail::_S_partition_sse41(in, n, pivot, left, right, or_equal);
+#endif
+        }
+
+        return detail::_S_partition_scalar(in, n, pivot, left, right, or_equal);
+    }
+
+    /// Minimum and maximum of `n >= 1` elements in a single pass.
+    template<typename T>
+    auto minmax(const T* data, std::size_t n) noexcept
+        -> std::pair<T, T>
+    {
+        if constexpr (std::same_as<T, float>)
+        {
+#if SV_SIMD_X86
+            if (isa() == Isa::AVX2)
+                return detail::_S_minmax_avx2(data, n);
+
+            if (isa() == Isa::SSE41)
+                return detail::_S_minmax_sse41(data, n);
+#endif
+        }
+
+        return detail::_S_minmax_scalar(data, n);
+    }
+
+    /// Index of the first element smaller than its predecessor, or `n`
+    /// when the range is sorted.
+    template<typename T>
+    auto sorted_until(const T* data, std::size_t n) noexcept
+        -> std::size_t
+    {
+        if constexpr (std::same_as<T, float>)
+        {
+#if SV_SIMD_X86
+            if (isa() == Isa::AVX2)
+                return detail::_S_sorted_until_avx2(data, n);
+
+            if (isa() == Isa::SSE41)
+                return detail::_S_sorted_until_sse41(data, n);
+#endif
+        }
+
+        return detail::_S_sorted_until_scalar(data, 0uL, n);
+    }
+
+}  /// namespace sv::simd
+
+#endif  // SV_SIMD
@@ -1,19 +1,31 @@
 #ifndef SV_SORTER
 #   define SV_SORTER
 
+#include <sv/control.hxx>
 #include <sv/elements.hxx>
+#include <sv/perf.hxx>
+#include <sv/replay.hxx>
+#include <sv/simd.hxx>
 #include <sv/sound.hxx>
+#include <sv/thread_pool.hxx>
+#include <sv/trace.hxx>
 #include <sv/viewer.hxx>
 
 #include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <chrono>
+#include <ctime>
 #include <exception>
+#include <filesystem>
+#include <iomanip>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <random>
 #include <ranges>
 #include <sstream>
+#include <stop_token>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -22,6 +34,7 @@
 #include <utility>
 #include <vector>
 
+namespace fs = std::filesystem;
 using namespace std::literals;
 
 namespace sv
@@ -67,8 +80,14 @@ namespace sv
             , m_sorted{ true }
             , m_start_time_point{ time_point_type{} }
             , m_end_time_point{ time_point_type{} }
-            , m_sorter{ std::thread{} }
-        { }
+            , m_sorter{ std::jthread{} }
+            , m_control{ std::make_shared<Control>() }
+            , m_recording{ false }
+            , m_trace_dir{ "traces"s }
+            , m_trace_path{ }
+            , m_trace_pending{ false }
+            , m_replay{ nullptr }
+        { m_elems->control(m_control); }
 
     public:
 
@@ -91,8 +110,8 @@ namespace sv
 
         ~Sorter() noexcept
         {
-            if (m_sorter.joinable())
-                m_sorter.detach();
+            stop();
+            m_elems->control(nullptr);
 
             m_sorted    = false;
             m_sorting   = false;
@@ -106,29 +125,51 @@ namespace sv
             if (m_algorithms.find(m_current_algorithm_name) != m_algorithms.cend() || m_current_algorithm_name == "Check"s || m_current_algorithm_name == "Shuffle"s)
             {
                 m_sorting = true;
+                m_replay.reset();
 
                 m_start_time_point  = time_point_type{};
                 m_end_time_point    = time_point_type{};
-                auto&& [r, w, a]    = m_elems->delays();
-                a                   = duration_type{};
 
                 if (m_sorter.joinable())
                     m_sorter.join();
 
-                m_sorter = std::thread{ std::mem_fn(&Sorter::sort), this };
+                m_control->resume();
+                m_sorter = std::jthread{ [this, name = m_current_algorithm_name](std::stop_token token)
+                { sort(std::move(token), name); } };
             }
             else
                 std::clog << "No algorithm selected to start." << std::endl;            
         }
 
+        /// Asks the sorting thread to stop and waits for it. The running
+        /// algorithm unwinds at its next element access, even if paused.
         auto stop() noexcept -> void 
         {
-            m_sorting = false;
+            m_sorter.request_stop();
 
             if (m_sorter.joinable())
                 m_sorter.join();
 
-            // m_sfx->toggle_mute();
+            m_sorting = false;
+
+            if (m_sfx)
+                m_sfx->stop();
+        }
+
+        auto paused() const noexcept
+            -> bool
+        { return m_control->paused(); }
+
+        auto toggle_pause() noexcept
+            -> void
+        { m_control->toggle_pause(); }
+
+        /// Lets `n` element accesses through while paused.
+        auto advance(size_type n) noexcept
+            -> void
+        {
+            if (m_sorting && m_control->paused())
+                m_control->step(n);
         }
 
         auto select_algorithm(const std::string& name) -> void
@@ -165,25 +206,49 @@ namespace sv
             }
         }
 
-        auto sort() noexcept
+        auto sort(std::stop_token token, const std::string& name) noexcept
             -> void
         {
+            if (auto& pacer { m_elems->pacer() }; pacer)
+                pacer->bind(token);
+
+            m_control->bind(std::move(token));
             m_viewer->unmark_range(0uL, m_elems->size());
 
-            if (m_current_algorithm_name == "Check"s)
-                check();
-            else if (m_current_algorithm_name == "Shuffle"s)
-                shuffle();
-            else
+            try
             {
-                m_elems->reset_counters();
-                m_start_time_point = clock_type::now();
-                std::get<2>(m_algorithms[m_current_algorithm_name])(m_elems, m_viewer);
-                m_sorting = false;
-                check();
-                // m_sfx->stop();
+                if (name == "Check"s)
+                    check();
+                else if (name == "Shuffle"s)
+                    shuffle();
+                else if (m_recording)
+                    record(name);
+                else
+                {
+                    m_elems->reset_counters();
+                    m_perf.start(parallel::pool().threads());
+                    m_start_time_point = clock_type::now();
+                    std::get<2>(m_algorithms.at(name))(m_elems, m_viewer);
+                    m_perf.stop();
+                    m_sorting = false;
+                    check();
+                    // m_sfx->stop();
+                }
+            }
+            catch (const sort_cancelled& e)
+            {
+                std::clog << e.what() << "." << std::endl;
+                m_end_time_point = clock_type::now();
+                m_sorted = false;
+                m_viewer->unmark_range(0uL, m_elems->size());
+            }
+            catch (const std::exception& e)
+            {
+                std::clog << e.what() << std::endl;
             }
 
+            m_perf.stop();
+            m_control->resume();
             m_sorting = false;
         }
 
@@ -213,9 +278,15 @@ namespace sv
         { 
             if (m_sorting)
                 m_end_time_point = clock_type::now();
-            return std::chrono::duration_cast<std::chrono::milliseconds>(m_end_time_point - m_start_time_point); 
+            return std::chrono::duration_cast<std::chrono::milliseconds>(m_end_time_point.load() - m_start_time_point.load()); 
         }
 
+        /// Hardware (or fallback) counters of the running sort, or of
+        /// the last one once it has finished.
+        auto perf() const noexcept
+            -> const PerfCounters&
+        { return m_perf; }
+
         auto algorithm_keybinds(std::stringstream& ss) 
             -> void
         {
@@ -237,16 +308,48 @@ namespace sv
             );
         }
 
-        auto adjust_delay(duration_type rdelay, duration_type wdelay)
-            noexcept -> void
+        /// Time the sort has actually spent computing: the elapsed time
+        /// less what was spent blocked by the pacer or paused.
+        auto compute_time() noexcept
+            -> std::chrono::milliseconds
         {
-            auto&& [rdd, wrd, _] = m_elems->delays();
+            auto stalled { m_control->held() };
 
-            rdd += rdelay;
-            wrd += wdelay;
+            if (auto& pacer { m_elems->pacer() }; pacer)
+                stalled += pacer->stalled();
 
-            rdd = std::ranges::clamp(rdd, std::chrono::microseconds::zero(), std::chrono::microseconds::max());
-            wrd = std::ranges::clamp(wrd, std::chrono::microseconds::zero(), std::chrono::microseconds::max());
+            return std::max(
+                elapsed_time() - std::chrono::duration_cast<std::chrono::milliseconds>(stalled),
+                std::chrono::milliseconds::zero()
+            );
+        }
+
+        /// Scales the target operations per second by `factor`.
+        auto adjust_speed(double factor)
+            -> void
+        {
+            if (auto& pacer { m_elems->pacer() }; pacer)
+                pacer->scale_rate(factor);
+        }
+
+        auto toggle_mute() noexcept
+            -> void
+        {
+            if (m_sfx)
+                m_sfx->toggle_mute();
+        }
+
+        auto muted() const noexcept
+            -> bool
+        { return !m_sfx || m_sfx->muted(); }
+
+        /// Switches between deadline pacing and releasing a fixed number
+        /// of operations per rendered frame.
+        auto toggle_frame_lock()
+            -> void
+        {
+            if (auto& pacer { m_elems->pacer() }; pacer)
+                pacer->toggle_mode();
         }
 
         auto resize(size_type new_size)
@@ -254,19 +357,18 @@ namespace sv
         {
             if (!m_sorting)
             {
+                m_replay.reset();
                 m_elems->resize(new_size);
                 m_viewer->resize(new_size);
             }
         }
 
-        constexpr auto 
-        sorted() 
-            noexcept -> bool&
+        auto sorted() const
+            noexcept -> bool
         { return m_sorted; }
 
-        constexpr auto 
-        sorting() 
-            noexcept -> bool&
+        auto sorting() const
+            noexcept -> bool
         { return m_sorting; }
 
         auto check() -> void
@@ -274,18 +376,28 @@ namespace sv
             auto n { m_elems->size() - 1uL };
             auto c { 0uL };
 
+            /// The verdict comes from one vector scan; the sweep below
+            /// only animates it up to the first out of order element.
+            auto until { simd::sorted_until(m_elems->items().data(), m_elems->size()) };
+
             m_viewer->mark(0uL, sf::Color::Green);
 
             for (; c < n; ++c)
             {
-                auto val = m_elems->items().at(c);
-                if (val > m_elems->items().at(c + 1uL))
+                m_control->checkpoint();
+
+                if (c + 1uL == until)
                 {
                     m_viewer->mark(c + 1, sf::Color::Red);
+
+                    if (m_sfx)
+                        m_sfx->play(Sound::SFX_Option::NOT_SORTED, 1.0f);
                     break;
                 }
 
-                // m_sfx->play(Sound::SFX_Option::CHECK, 0.5f + (0.5f + (val / m_elems->max_value())));
+                if (m_sfx)
+                    m_sfx->play(Sound::SFX_Option::CHECK, m_elems->items()[c + 1uL] / m_elems->max_value());
+
                 m_viewer->mark(c + 1, sf::Color::Green);
                 std::this_thread::sleep_for(2000.0ms / n);
             }
@@ -296,7 +408,9 @@ namespace sv
             {
                 m_viewer->mark(n, sf::Color::Green);
                 std::this_thread::sleep_for(500ms);
-                // m_sfx->play(Sound::SFX_Option::SORTED, 1);
+
+                if (m_sfx)
+                    m_sfx->play(Sound::SFX_Option::SORTED, 1.0f);
             }
         }
 
@@ -306,20 +420,168 @@ namespace sv
             auto eng    =  std::mt19937{ rd() };
 
             std::ranges::shuffle(m_elems->items(), eng);
+            m_viewer->touch_all();
             m_sorted = false;
         }
 
+        /// Runs the current algorithm unthrottled while writing every
+        /// operation and mark to a trace file, which is then picked up
+        /// by `update_replay` for playback.
+        auto record(const std::string& alg_name) -> void
+        {
+            auto now    = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+            auto tm     = std::tm{};
+            localtime_r(&now, &tm);
+
+            auto name = alg_name;
+            std::ranges::transform(name, name.begin(), [](unsigned char c)
+            { return std::isalnum(c) ? static_cast<char>(std::tolower(c)) : '-'; });
+
+            auto ss = std::stringstream{};
+            ss << name << "-" << std::put_time(&tm, "%Y%m%d-%H%M%S") << ".svtrace";
+
+            auto path { m_trace_dir / ss.str() };
+            auto writer = std::shared_ptr<TraceWriter>{};
+
+            m_elems->reset_counters();
+
+            try
+            {
+                fs::create_directories(m_trace_dir);
+                writer = std::make_shared<TraceWriter>(
+                    path,
+                    m_elems->items(),
+                    m_viewer->colours(),
+                    m_elems->max_value(),
+                    [elems = m_elems.get()]()
+                    {
+                        const auto& [c, r, w, s] = elems->counters();
+                        return TraceWriter::counters_type{ c, r, w, s };
+                    }
+                );
+            }
+            catch (const std::exception& e)
+            {
+                std::clog << e.what() << std::endl;
+                return;
+            }
+
+            auto pacer  { m_elems->pacer() };
+            auto rate   { pacer ? pacer->rate() : Pacer::unthrottled };
+
+            if (pacer)
+                pacer->set_rate(Pacer::unthrottled);
+
+            m_elems->trace(writer);
+            m_viewer->trace(writer);
+
+            auto detach = [&]
+            {
+                m_elems->trace(nullptr);
+                m_viewer->trace(nullptr);
+
+                if (pacer)
+                    pacer->set_rate(rate);
+            };
+
+            try
+            {
+                m_perf.start(parallel::pool().threads());
+                m_start_time_point = clock_type::now();
+                std::get<2>(m_algorithms.at(alg_name))(m_elems, m_viewer);
+                m_end_time_point = clock_type::now();
+                m_perf.stop();
+            }
+            catch (...)
+            {
+                detach();
+                writer.reset();
+
+                auto ec = std::error_code{};
+                fs::remove(path, ec);
+                throw;
+            }
+
+            detach();
+
+            try
+            {
+                writer->close();
+                std::clog << "Recorded " << writer->events() << " events to " << path << std::endl;
+
+                m_trace_path = path;
+                m_trace_pending = true;
+            }
+            catch (const std::exception& e)
+            {
+                std::clog << e.what() << std::endl;
+            }
+        }
+
+        auto recording() const
+            noexcept -> bool
+        { return m_recording; }
+
+        /// Takes effect from the next sort; the sorting thread reads it
+        /// once as it starts.
+        auto toggle_recording() noexcept
+            -> void
+        { m_recording = !m_recording; }
+
+        /// Called once per frame from the render loop. Loads a freshly
+        /// recorded trace and advances the active replay by `dt`.
+        auto update_replay(std::chrono::duration<double> dt)
+            -> void
+        {
+            if (!m_sorting && m_trace_pending.exchange(false))
+                replay_last();
+
+            if (m_replay)
+                m_replay->advance(dt);
+        }
+
+        auto replay_last() -> void
+        {
+            if (m_sorting || m_trace_path.empty())
+                return;
+
+            try
+            {
+                m_replay = std::make_shared<Replayer>(m_trace_path, m_elems, m_viewer);
+            }
+            catch (const std::exception& e)
+            {
+                std::clog << e.what() << std::endl;
+                m_replay.reset();
+            }
+        }
+
+        auto stop_replay() noexcept
+            -> void
+        { m_replay.reset(); }
+
+        auto replay() noexcept
+            -> std::shared_ptr<Replayer>
+        { return m_replay; }
+
     private:
         std::shared_ptr<Elements>   m_elems;
         std::shared_ptr<Viewer>     m_viewer;
         std::shared_ptr<Sound>      m_sfx;
         map_type                    m_algorithms;
         std::string                 m_current_algorithm_name;
-        bool                        m_sorting;
-        bool                        m_sorted;
-        time_point_type             m_start_time_point;
-        time_point_type             m_end_time_point;
-        std::thread                 m_sorter;
+        std::atomic<bool>           m_sorting;
+        std::atomic<bool>           m_sorted;
+        std::atomic<time_point_type> m_start_time_point;
+        std::atomic<time_point_type> m_end_time_point;
+        std::jthread                m_sorter;
+        std::shared_ptr<Control>    m_control;
+        std::atomic<bool>           m_recording;
+        fs::path                    m_trace_dir;
+        fs::path                    m_trace_path;
+        std::atomic<bool>           m_trace_pending;
+        std::shared_ptr<Replayer>   m_replay;
+        PerfCounters                m_perf;
     };  /// Sorter
 
 }  /// namespace sv
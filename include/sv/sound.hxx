@@ -3,20 +3,262 @@
 
 #include <SFML/Audio.hpp>
 
+#include <sv/spsc.hxx>
+
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
 #include <filesystem>
 #include <iostream>
-#include <ranges>
+#include <memory>
+#include <numbers>
 #include <source_location>
 #include <string>
-#include <unordered_map>
-#include <utility>
+#include <vector>
 
 namespace fs = std::filesystem;
 using namespace std::literals;
 
 namespace sv
 {
+    /// Streams tones synthesized from the accesses the sorting threads
+    /// report. Every producing thread claims a lane of its own, a single
+    /// producer ring the audio thread drains once per buffer; the events
+    /// drained are thinned out to a few voices, so the buffer plays the
+    /// same handful of tones whether the sort ran ten operations in it or
+    /// a hundred thousand. Lanes also skip events at a stride the audio
+    /// thread sets from how many were offered in the last buffer, which
+    /// keeps a push a few relaxed loads and stores at any speed.
+    class Synth : public sf::SoundStream
+    {
+    public:
+
+        using sample_type   = sf::Int16;
+        using size_type     = std::size_t;
+
+        enum class Timbre : std::uint8_t
+        { SINE, TRIANGLE, SQUARE };
+
+        struct Event
+        {
+            float   value;
+            Timbre  timbre;
+        };
+
+    public:
+
+        Synth()
+            : m_lanes{ std::make_shared<lanes_type>() }
+            , m_pending{ }
+            , m_samples(s_buffer, sample_type{})
+            , m_flush{ false }
+            , m_phase{ 0.0 }
+            , m_frequency{ _S_frequency(0.0f) }
+            , m_target{ m_frequency }
+            , m_level{ 0.0 }
+            , m_gate{ 0uL }
+            , m_timbre{ Timbre::SINE }
+        {
+            m_pending.reserve(s_lanes * s_capacity);
+            initialize(1u, s_sample_rate);
+        }
+
+        Synth(const Synth&) = delete;
+        auto operator= (const Synth&) -> Synth& = delete;
+
+        ~Synth() override
+        { stop(); }
+
+        /// Called from the sorting threads for every access. `value` is
+        /// the element as a fraction of the largest one.
+        auto push(float value, Timbre timbre) noexcept
+            -> void
+        {
+            auto* lane { _M_lane() };
+
+            if (!lane) [[unlikely]]
+                return;
+
+            lane->offered.store(lane->offered.load(std::memory_order_relaxed) + 1uL, std::memory_order_relaxed);
+
+            if (++lane->skipped < lane->stride.load(std::memory_order_relaxed))
+                return;
+
+            lane->skipped = 0uL;
+            lane->queue.try_push(Event{ value, timbre });
+        }
+
+        /// Drops whatever is queued and lets the tone fade out.
+        auto flush() noexcept
+            -> void
+        { m_flush.store(true, std::memory_order_relaxed); }
+
+    protected:
+
+        auto onGetData(Chunk& data)
+            -> bool override
+        {
+            m_pending.clear();
+
+            for (auto& lane : *m_lanes)
+            {
+                auto offered { lane.offered.load(std::memory_order_relaxed) };
+                lane.stride.store(std::max((offered - lane.seen) / (s_capacity / 2uL), 1uL), std::memory_order_relaxed);
+                lane.seen = offered;
+
+                lane.queue.drain([&](const Event& e){ m_pending.push_back(e); });
+            }
+
+            if (m_flush.exchange(false, std::memory_order_relaxed))
+            {
+                m_pending.clear();
+                m_gate = 0uL;
+            }
+
+            _M_synthesize();
+
+            data.samples        = m_samples.data();
+            data.sampleCount    = m_samples.size();
+            return true;
+        }
+
+        /// A live stream has nothing to seek.
+        auto onSeek(sf::Time) -> void override
+        { }
+
+    private:
+
+        static constexpr auto s_sample_rate { 44'100u };
+        static constexpr auto s_buffer      { 512uL };      /// ~12 ms per buffer
+        static constexpr auto s_voices      { 8uL };        /// tones per buffer, at most
+        static constexpr auto s_hold        { 1'200uL };    /// samples a tone sounds for
+        static constexpr auto s_lanes       { 16uL };
+        static constexpr auto s_capacity    { 1'024uL };
+        static constexpr auto s_volume      { 0.2 };
+
+        struct alignas(64) Lane
+        {
+            SpscQueue<Event, s_capacity>    queue;
+            std::atomic<size_type>          offered { 0uL };    /// written by the producer
+            std::atomic<size_type>          stride  { 1uL };    /// written by the audio thread
+            std::atomic<bool>               taken   { false };
+            size_type                       skipped { 0uL };    /// producer only
+            size_type                       seen    { 0uL };    /// audio thread only
+        };
+
+        using lanes_type = std::array<Lane, s_lanes>;
+
+        /// A thread's lane, given back when the thread exits. The claim
+        /// shares the lanes so it can outlive the synth.
+        struct Claim
+        {
+            std::shared_ptr<lanes_type>     lanes   { nullptr };
+            Lane*                           lane    { nullptr };
+
+            ~Claim()
+            { release(); }
+
+            auto release() noexcept
+                -> void
+            {
+                if (lane)
+                    lane->taken.store(false, std::memory_order_release);
+
+                lane = nullptr;
+            }
+        };
+
+        /// Threads past the first `s_lanes` at once stay silent rather
+        /// than share a ring.
+        auto _M_lane() noexcept
+            -> Lane*
+        {
+            thread_local auto claim = Claim{};
+
+            if (claim.lanes.get() != m_lanes.get()) [[unlikely]]
+            {
+                claim.release();
+                claim.lanes = m_lanes;
+
+                for (auto& lane : *m_lanes)
+                    if (!lane.taken.exchange(true, std::memory_order_acq_rel))
+                    {
+                        claim.lane = &lane;
+                        break;
+                    }
+            }
+
+            return claim.lane;
+        }
+
+        /// Splits the buffer evenly between up to `s_voices` of the
+        /// pending events, picked at even steps through them. The pitch
+        /// glides to each new tone and the phase runs on, so changes
+        /// don't click.
+        auto _M_synthesize() noexcept
+            -> void
+        {
+            auto voices     { std::min(m_pending.size(), s_voices) };
+            auto segment    { voices ? s_buffer / voices : s_buffer };
+
+            for (auto i { 0uL }; i < s_buffer; ++i)
+            {
+                if (voices && i % segment == 0uL && i / segment < voices)
+                {
+                    const auto& e = m_pending[(i / segment) * m_pending.size() / voices];
+
+                    m_target    = _S_frequency(e.value);
+                    m_timbre    = e.timbre;
+                    m_gate      = std::max(s_hold, segment);
+                }
+
+                m_frequency += (m_target - m_frequency) * 0.05;
+                m_level     += ((m_gate ? 1.0 : 0.0) - m_level) * (m_gate ? 0.01 : 0.0005);
+                m_gate      -= m_gate ? 1uL : 0uL;
+
+                m_phase += m_frequency / s_sample_rate;
+                m_phase -= std::floor(m_phase);
+
+                m_samples[i] = static_cast<sample_type>(32'767.0 * s_volume * m_level * _S_wave(m_phase, m_timbre));
+            }
+        }
+
+        /// Four and a half octaves up from A2.
+        static auto _S_frequency(float value) noexcept
+            -> double
+        { return 110.0 * std::exp2(4.5 * std::clamp(static_cast<double>(value), 0.0, 1.0)); }
+
+        static auto _S_wave(double phase, Timbre timbre) noexcept
+            -> double
+        {
+            switch (timbre)
+            {
+                case Timbre::TRIANGLE:  return 4.0 * std::abs(phase - 0.5) - 1.0;
+                case Timbre::SQUARE:    return phase < 0.5 ? 0.5 : -0.5;
+                default:                return std::sin(2.0 * std::numbers::pi * phase);
+            }
+        }
+
+    private:
+
+        std::shared_ptr<lanes_type>     m_lanes;
+        std::vector<Event>              m_pending;
+        std::vector<sample_type>        m_samples;
+        std::atomic<bool>               m_flush;
+
+        double                          m_phase;
+        double                          m_frequency;
+        double                          m_target;
+        double                          m_level;
+        size_type                       m_gate;
+        Timbre                          m_timbre;
+
+    };  /// class Synth
+
+    /// Sonifies a sort: reads, writes and the check sweep go to the
+    /// synth as tones, the verdict plays a sample.
     class Sound
     {
     public:
@@ -30,14 +272,9 @@ namespace sv
     public:
 
         Sound() noexcept
-            : m_read{ sound_type{} }
-            , m_write{ sound_type{} }
-            , m_check{ sound_type{} }
+            : m_synth{ }
             , m_sorted{ sound_type{} }
             , m_not_sorted{ sound_type{} }
-            , m_read_buffer{ sound_buffer_type{} }
-            , m_write_buffer{ sound_buffer_type{} }
-            , m_check_buffer{ sound_buffer_type{} }
             , m_sorted_buffer{ sound_buffer_type{} }
             , m_not_sorted_buffer{ sound_buffer_type{} }
             , m_muted{ false }
@@ -47,117 +284,40 @@ namespace sv
             auto asset_path     = src_path.remove_filename() / "../../assets"s;
 
             auto all_loaded {
-                m_read_buffer.loadFromFile(asset_path / "read.wav"s)
-             && m_write_buffer.loadFromFile(asset_path / "write.wav"s)
-             && m_check_buffer.loadFromFile(asset_path / "check.wav"s)
-             && m_sorted_buffer.loadFromFile(asset_path / "hoorah.wav"s)
+                m_sorted_buffer.loadFromFile(asset_path / "hoorah.wav"s)
              && m_not_sorted_buffer.loadFromFile(asset_path / "no.wav"s)
             };
 
             all_loaded ? (std::clog << "") : (std::clog << "Error loading audio files!" << std::endl);
 
-            m_read.setBuffer(m_read_buffer);
-            m_write.setBuffer(m_write_buffer);
-            m_check.setBuffer(m_check_buffer);
             m_sorted.setBuffer(m_sorted_buffer);
             m_not_sorted.setBuffer(m_not_sorted_buffer);
-        }
-
-        Sound(const Sound& sound) noexcept
-            : m_read{ sound.m_read }
-            , m_write{ sound.m_write }
-            , m_check{ sound.m_check }
-            , m_sorted{ sound.m_sorted }
-            , m_not_sorted{ sound.m_not_sorted }
-            , m_read_buffer{ sound.m_read_buffer }
-            , m_write_buffer{ sound.m_write_buffer }
-            , m_check_buffer{ sound.m_check_buffer }
-            , m_sorted_buffer{ sound.m_sorted_buffer }
-            , m_not_sorted_buffer{ sound.m_not_sorted_buffer }
-            , m_muted{ sound.m_muted }
-        { }
-
-        Sound(Sound&& sound) noexcept
-            : m_read{ std::move(sound.m_read) }
-            , m_write{ std::move(sound.m_write) }
-            , m_check{ std::move(sound.m_check) }
-            , m_sorted{ std::move(sound.m_sorted) }
-            , m_not_sorted{ std::move(sound.m_not_sorted) }
-            , m_read_buffer{ std::move(sound.m_read_buffer) }
-            , m_write_buffer{ std::move(sound.m_write_buffer) }
-            , m_check_buffer{ std::move(sound.m_check_buffer) }
-            , m_sorted_buffer{ std::move(sound.m_sorted_buffer) }
-            , m_not_sorted_buffer{ std::move(sound.m_not_sorted_buffer) }
-            , m_muted{ sound.m_muted }
-        { }
-
-        // ~Sound() noexcept
-        // {
-        //     std::ranges::for_each(m_sound_map | std::views::values, [](auto& x){ x.stop(); });
-        //     m_sound_map.erase(m_sound_map.begin(), m_sound_map.end());
-        // }
-
-        auto operator= (const Sound& sound) noexcept
-            -> Sound&
-        {
-            m_read = sound.m_read;
-            m_write = sound.m_write;
-            m_check = sound.m_check;
-            m_sorted = sound.m_sorted;
-            m_not_sorted = sound.m_not_sorted;
 
-
-            m_read_buffer = sound.m_read_buffer;
-            m_write_buffer = sound.m_write_buffer;
-            m_check_buffer = sound.m_check_buffer;
-            m_sorted_buffer = sound.m_sorted_buffer;
-            m_not_sorted_buffer = sound.m_not_sorted_buffer;
-
-            m_muted = sound.m_muted;
-
-            return *this;
+            m_synth.play();
         }
 
-        auto operator= (Sound&& sound) noexcept
-            -> Sound&
-        {
-            m_read = std::move(sound.m_read);
-            m_write = std::move(sound.m_write);
-            m_check = std::move(sound.m_check);
-            m_sorted = std::move(sound.m_sorted);
-            m_not_sorted = std::move(sound.m_not_sorted);
-
-            m_read_buffer = std::move(sound.m_read_buffer);
-            m_write_buffer = std::move(sound.m_write_buffer);
-            m_check_buffer = std::move(sound.m_check_buffer);
-            m_sorted_buffer = std::move(sound.m_sorted_buffer);
-            m_not_sorted_buffer = std::move(sound.m_not_sorted_buffer);
+        Sound(const Sound&) = delete;
+        auto operator= (const Sound&) -> Sound& = delete;
 
-            m_muted = std::move(sound.m_muted);
-
-            return *this;
-        }
-
-        auto play([[maybe_unused]] SFX_Option sfx_option, [[maybe_unused]] float pitch) noexcept -> void
+        /// `value` is the element as a fraction of the largest one; the
+        /// samples ignore it. Safe to call from any sorting thread.
+        auto play(SFX_Option sfx_option, float value) noexcept -> void
         {
-            if (m_muted)
+            if (m_muted.load(std::memory_order_relaxed))
                 return;
             else
                 switch (sfx_option)
                 {
                 case SFX_Option::READ:
-                    m_read.play();
-                    m_read.setPitch(pitch);
+                    m_synth.push(value, Synth::Timbre::SINE);
                     break;
 
                 case SFX_Option::WRITE:
-                    m_read.play();
-                    m_read.setPitch(pitch);
+                    m_synth.push(value, Synth::Timbre::TRIANGLE);
                     break;
 
                 case SFX_Option::CHECK:
-                    m_read.play();
-                    m_read.setPitch(pitch);
+                    m_synth.push(value, Synth::Timbre::SQUARE);
                     break;
 
                 case SFX_Option::SORTED:
@@ -167,39 +327,38 @@ namespace sv
                 case SFX_Option::NOT_SORTED:
                     m_not_sorted.play();
                     break;
-                
+
                 default:
                     std::clog << "Could not find requested sound" << std::endl;
-                }                    
+                }
         }
-        
+
+        /// Silences the tones still queued, eg. when a sort is cancelled.
         auto stop() noexcept -> void
-        {
-            m_read.stop();
-            m_write.stop();
-        }
-        
+        { m_synth.flush(); }
+
         auto toggle_mute() noexcept -> void
         {
             stop();
-            m_muted ^= true;
+            m_muted = !m_muted;
+            m_muted ? m_synth.pause() : m_synth.play();
         }
 
+        auto muted() const noexcept
+            -> bool
+        { return m_muted; }
+
     private:
 
-        sound_type          m_read;
-        sound_type          m_write;
-        sound_type          m_check;
+        Synth               m_synth;
+
         sound_type          m_sorted;
         sound_type          m_not_sorted;
 
-        sound_buffer_type   m_read_buffer;
-        sound_buffer_type   m_write_buffer;
-        sound_buffer_type   m_check_buffer;
         sound_buffer_type   m_sorted_buffer;
         sound_buffer_type   m_not_sorted_buffer;
 
-        bool                m_muted;
+        std::atomic<bool>   m_muted;
 
     };  /// class Sound
 }
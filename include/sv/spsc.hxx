@@ -0,0 +1,88 @@
+#ifndef SV_SPSC
+#   define SV_SPSC
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+
+namespace sv
+{
+    /// Bounded lock-free ring between exactly one producer and one
+    /// consumer. Each side owns one index; the producer also keeps its
+    /// last view of the consumer's, so a push only reads the shared line
+    /// when the ring looks full. Pushing into a full ring fails instead
+    /// of waiting.
+    template<typename T, std::size_t N>
+        requires (std::has_single_bit(N))
+    class SpscQueue
+    {
+    public:
+
+        using value_type    = T;
+        using size_type     = std::size_t;
+
+    public:
+
+        SpscQueue() noexcept = default;
+
+        SpscQueue(const SpscQueue&) = delete;
+        auto operator= (const SpscQueue&) -> SpscQueue& = delete;
+
+        /// Producer only.
+        auto try_push(const T& value) noexcept
+            -> bool
+        {
+            auto tail { m_tail.load(std::memory_order_relaxed) };
+
+            if (tail - m_head_cache == N)
+            {
+                m_head_cache = m_head.load(std::memory_order_acquire);
+
+                if (tail - m_head_cache == N)
+                    return false;
+            }
+
+            m_slots[tail & s_mask] = value;
+            m_tail.store(tail + 1uL, std::memory_order_release);
+            return true;
+        }
+
+        /// Consumer only. Hands everything pushed so far to `f`, oldest
+        /// first, and returns how many there were.
+        template<typename F>
+        auto drain(F&& f)
+            -> size_type
+        {
+            auto head { m_head.load(std::memory_order_relaxed) };
+            auto tail { m_tail.load(std::memory_order_acquire) };
+
+            for (auto i { head }; i != tail; ++i)
+                f(m_slots[i & s_mask]);
+
+            m_head.store(tail, std::memory_order_release);
+            return tail - head;
+        }
+
+        auto size() const noexcept
+            -> size_type
+        { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire); }
+
+        static constexpr auto capacity() noexcept
+            -> size_type
+        { return N; }
+
+    private:
+
+        static constexpr auto s_mask { N - 1uL };
+
+        alignas(64) std::atomic<size_type>  m_tail          { 0uL };
+        size_type                           m_head_cache    { 0uL };
+        alignas(64) std::atomic<size_type>  m_head          { 0uL };
+        alignas(64) std::array<T, N>        m_slots         { };
+
+    };  /// class SpscQueue
+
+}  /// namespace sv
+
+#endif  // SV_SPSC
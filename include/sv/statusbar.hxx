@@ -4,10 +4,15 @@
 #include <SFML/Graphics.hpp>
 
 #include <sv/elements.hxx>
+#include <sv/pacer.hxx>
+#include <sv/perf.hxx>
+#include <sv/simd.hxx>
 #include <sv/sorter.hxx>
+#include <sv/thread_pool.hxx>
 
 #include <algorithm>
 #include <filesystem>
+#include <iomanip>
 #include <iostream>
 #include <memory>
 #include <ranges>
@@ -84,7 +89,7 @@ namespace sv
         {
             auto ss = std::stringstream{};
             const auto& [cmps, reads, writes, swaps]    = m_elems->counters();
-            const auto& [rdelay, wdelay, accdelay]      = m_elems->delays();
+            auto aux                                    = m_elems->scratch().stats();
             const auto& time                            = m_sorter->elapsed_time();
 
             ss << "Algorithm Details:\n"
@@ -100,32 +105,59 @@ namespace sv
 
             ss << "Stats:\n"
                << "Elapsed Time: "        << static_cast<float>(time.count()) / 1000.0f << " s\n"
-               << "True Sorting Time: "   << (time - accdelay).count() << " ms\n"
+               << "True Sorting Time: "   << m_sorter->compute_time().count() << " ms\n"
                << " Comparisons: "        << cmps << "\n"
                << " Read count: "         << reads << "\n"
                << " Write count: "        << writes << "\n"
                << " Swap count: "         << swaps << "\n"
-               << " Read delay: "         << static_cast<float>(rdelay.count()) / 1000.0 << " ms\n"
-               << " Write delay: "        << static_cast<float>(wdelay.count()) / 1000.0 << " ms\n"
+               << " Speed: "              << _M_speed() << "\n"
                << " Data size: "          << m_elems->size() << "\n"
+               << " Aux memory: "         << aux.peak / 1024uL << " KiB peak, "
+                                          << aux.allocations << " allocs, "
+                                          << aux.leases << " leases\n"
+               << " SIMD: "               << simd::isa_name() << "\n"
                << " Sorting?: "           << (m_sorter->sorting() ? "Yes" : "No") << "\n"
+               << " Paused?: "            << (m_sorter->paused() ? "Yes" : "No") << "\n"
                << " Sorted?: "            << (m_sorter->sorted() ? "Yes" : "No") << "\n"
-               << "-------------------------------------------\n"
+               << " Recording?: "         << (m_sorter->recording() ? "Yes" : "No") << "\n"
+               << " Sound?: "             << (m_sorter->muted() ? "No" : "Yes") << "\n";
+
+            _M_counters(ss);
+            _M_workers(ss);
+
+            if (auto replay { m_sorter->replay() }; replay)
+                ss << " Replay: "             << replay->path().filename().string() << "\n"
+                   << "  Step: "              << replay->position() << " / " << replay->events() << "\n"
+                   << "  Rate: "              << static_cast<std::size_t>(replay->rate()) << " ops/s "
+                   << (replay->forward() ? "forward" : "backward")
+                   << (replay->paused() ? " (paused)" : "") << "\n";
+
+            ss << "-------------------------------------------\n"
                << "Key map:\n"
                << " Commands:\n"
                << "  Start: Enter\n"
                << "  Exit: Esc\n"
+               << "  Cancel Sort: X\n"
+               << "  Pause/Resume Sort: Tab\n"
+               << "  Step Sort: N (Shift x100, Ctrl x10000)\n"
                << "  Check: C\n"
                << "  Shuffle: Space\n"
                << "  Number of Elements Adjustment\n"
-               << "    Increase: \"]\"\n"
-               << "    Decrease: \"[\"\n"
-               << "  Reading Delay Adjustment:\n"
-               << "    Increase: Up Arrow\n"
-               << "    Decrease: Down Arrow\n"
-               << "  Writing Delay Adjustment:\n"
-               << "    Increase: Right Arrow\n"
-               << "    Decrease: Left Arrow\n"
+               << "    Increase: \"]\" (Shift to double)\n"
+               << "    Decrease: \"[\" (Shift to halve)\n"
+               << "  Speed Adjustment (ops/s):\n"
+               << "    x2 / /2: Up / Down Arrow\n"
+               << "    x10 / /10: Right / Left Arrow\n"
+               << "    Frame Lock: F\n"
+               << "  Sound On/Off: V\n"
+               << "  Record Next Sort: F5\n"
+               << "  Replay Last Trace: F6\n"
+               << "  Replay Controls:\n"
+               << "    Play/Pause: Tab\n"
+               << "    Step: \",\" / \".\" (Shift x1000)\n"
+               << "    Seek Start/End: Home / End\n"
+               << "    Speed: \"-\" / \"=\"\n"
+               << "    Reverse: Backspace\n"
                << " Algorithms:\n";
 
             m_sorter->algorithm_keybinds(ss);            
@@ -137,6 +169,101 @@ namespace sv
             m_texture.display();
         }
 
+    private:
+
+        /// What the CPU did for the sort: cycles, cache and branch misses
+        /// where the host allows hardware counters, else CPU time and
+        /// what the software events saw. Phases show their share of the
+        /// sort's CPU time.
+        auto _M_counters(std::stringstream& ss) const
+            -> void
+        {
+            const auto& perf = m_sorter->perf();
+            auto totals { perf.totals() };
+
+            if (!totals.has(PerfEvent::CPU_TIME))
+                return;
+
+            ss << " Counters (" << source_name(totals.source) << "):\n"
+               << "  CPU time: " << std::fixed << std::setprecision(3)
+               << static_cast<double>(totals[PerfEvent::CPU_TIME]) / 1e6 << " ms\n";
+
+            if (totals.has(PerfEvent::CYCLES))
+                ss << "  Cycles: " << totals[PerfEvent::CYCLES]
+                   << " (IPC " << std::setprecision(2) << totals.ipc() << ")\n";
+
+            if (totals.has(PerfEvent::L1D_MISSES) || totals.has(PerfEvent::LLC_MISSES))
+                ss << "  L1D / LLC misses: " << totals[PerfEvent::L1D_MISSES]
+                   << " / " << totals[PerfEvent::LLC_MISSES] << "\n";
+
+            if (totals.has(PerfEvent::BRANCH_MISSES))
+                ss << "  Branch misses: " << totals[PerfEvent::BRANCH_MISSES] << "\n";
+
+            if (totals.has(PerfEvent::PAGE_FAULTS))
+                ss << "  Page faults: " << totals[PerfEvent::PAGE_FAULTS]
+                   << ", switches: " << totals[PerfEvent::CONTEXT_SWITCHES] << "\n";
+
+            auto phases { perf.phases() };
+            auto cpu    { std::max(totals[PerfEvent::CPU_TIME], 1uL) };
+            auto first  { true };
+
+            for (auto phase : perf_phases)
+                if (auto time { phases[static_cast<std::size_t>(phase)][PerfEvent::CPU_TIME] }; time != 0uL)
+                {
+                    ss << (first ? "  Phases: " : ", ") << phase_name(phase) << " "
+                       << std::setprecision(0) << 100.0 * static_cast<double>(time) / static_cast<double>(cpu) << "%";
+                    first = false;
+                }
+
+            if (!first)
+                ss << "\n";
+
+            ss << std::defaultfloat << std::setprecision(6);
+        }
+
+        /// Tasks run, tasks stolen and busy time for each pool worker,
+        /// two to a line. Only shown once a parallel sort has used it.
+        auto _M_workers(std::stringstream& ss) const
+            -> void
+        {
+            auto stats = parallel::pool().stats();
+
+            if (std::ranges::all_of(stats, [](const auto& w) { return w.tasks == 0uL; }))
+                return;
+
+            ss << " Workers: (tasks / steals / busy)\n";
+
+            for (auto w { 0uL }; w < stats.size(); ++w)
+            {
+                const auto& [tasks, steals, busy] = stats[w];
+
+                if (w + 1uL == stats.size())
+                    ss << (w % 2uL != 0uL ? "\n" : "") << "  Caller: ";
+                else
+                    ss << (w % 2uL == 0uL ? "  " : "   ") << "#" << w << ": ";
+
+                ss << tasks << " / " << steals << " / "
+                   << std::chrono::duration_cast<std::chrono::milliseconds>(busy).count() << "ms";
+
+                if (w % 2uL != 0uL || w + 1uL == stats.size())
+                    ss << "\n";
+            }
+        }
+
+        auto _M_speed() const
+            -> std::string
+        {
+            auto& pacer = m_elems->pacer();
+
+            if (!pacer || !pacer->throttled())
+                return "unthrottled"s;
+
+            auto ss = std::stringstream{};
+            ss << static_cast<std::size_t>(pacer->rate()) << " ops/s"
+               << (pacer->mode() == Pacer::Mode::FRAME ? " (frame locked)" : "");
+            return ss.str();
+        }
+
     private:
 
         float_type                  m_width;
@@ -0,0 +1,406 @@
+#ifndef SV_THREAD_POOL
+#   define SV_THREAD_POOL
+
+#include <pthread.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <latch>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sv::parallel
+{
+    /// A thread as the kernel (for its counters) and pthreads (for its
+    /// CPU clock) know it.
+    struct ThreadId
+    {
+        pid_t       tid;
+        pthread_t   handle;
+
+        static auto current() noexcept
+            -> ThreadId
+        { return ThreadId{ ::gettid(), ::pthread_self() }; }
+    };
+
+    /// Fixed-size work-stealing pool. Every worker owns a deque: tasks it
+    /// submits are pushed and popped at the back (depth first, cache
+    /// warm) while idle workers steal from the front of other deques
+    /// (the oldest and so largest pieces of work). Threads waiting on a
+    /// `TaskGroup` run queued tasks instead of blocking.
+    class ThreadPool
+    {
+    public:
+
+        using size_type         = std::size_t;
+        using task_type         = std::function<void()>;
+        using clock_type        = std::chrono::steady_clock;
+        using duration_type     = std::chrono::nanoseconds;
+
+        static constexpr auto npos { std::numeric_limits<size_type>::max() };
+
+        struct WorkerStats
+        {
+            size_type       tasks;
+            size_type       steals;
+            duration_type   busy;
+        };
+
+        /// Lends a pool to the calling thread for the scope's lifetime:
+        /// `parallel::pool()` returns it there, so the parallel
+        /// algorithms the thread runs fork onto it instead of the shared
+        /// pool.
+        class Scope
+        {
+        public:
+
+            explicit Scope(ThreadPool& pool) noexcept
+                : m_previous{ std::exchange(s_bound, &pool) }
+            { }
+
+            Scope(const Scope&) = delete;
+            auto operator= (const Scope&) -> Scope& = delete;
+
+            ~Scope() noexcept
+            { s_bound = m_previous; }
+
+        private:
+            ThreadPool*     m_previous;
+
+        };  /// class Scope
+
+    public:
+
+        explicit ThreadPool(size_type workers = std::max(1u, std::thread::hardware_concurrency()))
+            : m_workers{ }
+            , m_external{ }
+            , m_pending{ 0uL }
+            , m_next{ 0uL }
+            , m_threads{ }
+        {
+            for (auto w { 0uL }; w < workers; ++w)
+                m_workers.push_back(std::make_unique<Worker>());
+
+            auto started = std::latch{ static_cast<std::ptrdiff_t>(workers) };
+
+            for (auto w { 0uL }; w < workers; ++w)
+                m_threads.emplace_back([this, w, &started](std::stop_token token)
+                {
+                    m_workers[w]->thread = ThreadId::current();
+                    started.count_down();
+                    _M_work(w, token);
+                });
+
+            started.wait();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        auto operator= (const ThreadPool&) -> ThreadPool& = delete;
+
+        ~ThreadPool() noexcept
+        {
+            for (auto& thread : m_threads)
+                thread.request_stop();
+
+            m_threads.clear();
+        }
+
+        auto size() const noexcept
+            -> size_type
+        { return m_workers.size(); }
+
+        /// Index of the calling worker or `npos` for any other thread.
+        static auto current() noexcept
+            -> size_type
+        { return s_current; }
+
+        /// The pool the calling thread works for or was lent, if any.
+        static auto bound() noexcept
+            -> ThreadPool*
+        { return s_bound; }
+
+        auto submit(task_type task)
+            -> void
+        {
+            auto w { current() != npos ? current() : m_next.fetch_add(1uL, std::memory_order_relaxed) % size() };
+
+            {
+                auto lock = std::scoped_lock{ m_workers[w]->mutex };
+                m_workers[w]->tasks.push_back(std::move(task));
+            }
+
+            m_pending.fetch_add(1uL, std::memory_order_release);
+
+            {
+                auto lock = std::scoped_lock{ m_sleep_mutex };
+            }
+
+            m_sleep_cv.notify_one();
+        }
+
+        /// Runs one queued task on the calling thread, preferring the
+        /// caller's own deque. Returns false if there was nothing to run.
+        auto try_run_one()
+            -> bool
+        {
+            auto self   { current() };
+            auto task   = task_type{};
+
+            if (self != npos && _M_take(self, task, true))
+            {
+                _M_execute(*m_workers[self], task, false);
+                return true;
+            }
+
+            auto N      { size() };
+            auto start  { self != npos ? self + 1uL : m_next.load(std::memory_order_relaxed) };
+
+            for (auto k { 0uL }; k < N; ++k)
+                if (auto victim { (start + k) % N }; victim != self && _M_take(victim, task, false))
+                {
+                    _M_execute(self != npos ? *m_workers[self] : m_external, task, true);
+                    return true;
+                }
+
+            return false;
+        }
+
+        /// The worker threads, eg. to open counters on.
+        auto threads() const
+            -> std::vector<ThreadId>
+        {
+            auto threads = std::vector<ThreadId>{};
+
+            for (const auto& worker : m_workers)
+                threads.push_back(worker->thread);
+
+            return threads;
+        }
+
+        /// Per-worker counts followed by one entry for tasks run by
+        /// threads outside the pool while they waited.
+        auto stats() const
+            -> std::vector<WorkerStats>
+        {
+            auto stats = std::vector<WorkerStats>{};
+
+            for (const auto& worker : m_workers)
+                stats.push_back(worker->stats());
+
+            stats.push_back(m_external.stats());
+            return stats;
+        }
+
+        auto reset_stats() noexcept
+            -> void
+        {
+            for (auto& worker : m_workers)
+                worker->reset();
+
+            m_external.reset();
+        }
+
+    private:
+
+        struct Worker
+        {
+            std::mutex                      mutex;
+            std::deque<task_type>           tasks;
+            std::atomic<size_type>          executed    { 0uL };
+            std::atomic<size_type>          steals      { 0uL };
+            std::atomic<duration_type::rep> busy        { duration_type::rep{} };
+            ThreadId                        thread      { };
+
+            auto stats() const noexcept
+                -> WorkerStats
+            {
+                return WorkerStats{
+                    executed.load(std::memory_order_relaxed),
+                    steals.load(std::memory_order_relaxed),
+                    duration_type{ busy.load(std::memory_order_relaxed) }
+                };
+            }
+
+            auto reset() noexcept
+                -> void
+            {
+                executed.store(0uL, std::memory_order_relaxed);
+                steals.store(0uL, std::memory_order_relaxed);
+                busy.store(duration_type::rep{}, std::memory_order_relaxed);
+            }
+        };
+
+        inline static thread_local size_type s_current { npos };
+        inline static thread_local ThreadPool* s_bound { nullptr };
+
+        auto _M_take(size_type w, task_type& task, bool own)
+            -> bool
+        {
+            auto& worker = *m_workers[w];
+            auto lock = std::scoped_lock{ worker.mutex };
+
+            if (worker.tasks.empty())
+                return false;
+
+            if (own)
+            {
+                task = std::move(worker.tasks.back());
+                worker.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(worker.tasks.front());
+                worker.tasks.pop_front();
+            }
+
+            m_pending.fetch_sub(1uL, std::memory_order_relaxed);
+            return true;
+        }
+
+        auto _M_execute(Worker& worker, task_type& task, bool stolen)
+            -> void
+        {
+            auto start { clock_type::now() };
+
+            try { task(); }
+            catch (const std::exception& e) { std::clog << e.what() << std::endl; }
+            catch (...) { std::clog << "Unknown exception in pool task." << std::endl; }
+
+            worker.executed.fetch_add(1uL, std::memory_order_relaxed);
+            worker.busy.fetch_add(std::chrono::duration_cast<duration_type>(clock_type::now() - start).count(), std::memory_order_relaxed);
+
+            if (stolen)
+                worker.steals.fetch_add(1uL, std::memory_order_relaxed);
+        }
+
+        auto _M_work(size_type w, std::stop_token token)
+            -> void
+        {
+            s_current = w;
+            s_bound   = this;
+
+            while (!token.stop_requested())
+            {
+                if (try_run_one())
+                    continue;
+
+                auto lock = std::unique_lock{ m_sleep_mutex };
+                m_sleep_cv.wait(lock, token, [this]
+                { return m_pending.load(std::memory_order_acquire) != 0uL; });
+            }
+        }
+
+    private:
+        std::vector<std::unique_ptr<Worker>>    m_workers;
+        Worker                                  m_external;
+        std::atomic<size_type>                  m_pending;
+        std::atomic<size_type>                  m_next;
+        std::mutex                              m_sleep_mutex;
+        std::condition_variable_any             m_sleep_cv;
+        std::vector<std::jthread>               m_threads;
+
+    };  /// class ThreadPool
+
+    /// The pool the parallel algorithms fork onto: the one lent to the
+    /// calling thread by a `ThreadPool::Scope`, otherwise the pool shared
+    /// by everything else, sized to the host's hardware threads and
+    /// started on first use.
+    inline auto pool()
+        -> ThreadPool&
+    {
+        if (auto* bound { ThreadPool::bound() })
+            return *bound;
+
+        static auto instance = ThreadPool{};
+        return instance;
+    }
+
+    /// Fork-join scope over a pool. `wait` runs queued tasks until all
+    /// of the group's tasks have finished, then rethrows the first
+    /// exception any of them threw. Destroying a group also waits, so
+    /// tasks may safely refer to the enclosing stack frame.
+    class TaskGroup
+    {
+    public:
+
+        using size_type     = std::size_t;
+
+    public:
+
+        explicit TaskGroup(ThreadPool& pool = parallel::pool()) noexcept
+            : m_pool{ pool }
+            , m_outstanding{ 0uL }
+            , m_error{ nullptr }
+        { }
+
+        TaskGroup(const TaskGroup&) = delete;
+        auto operator= (const TaskGroup&) -> TaskGroup& = delete;
+
+        ~TaskGroup() noexcept
+        { _M_drain(); }
+
+        template<typename F>
+        auto run(F&& f)
+            -> void
+        {
+            m_outstanding.fetch_add(1uL, std::memory_order_relaxed);
+
+            m_pool.submit([this, f = std::forward<F>(f)]() mutable
+            {
+                try { f(); }
+                catch (...)
+                {
+                    auto lock = std::scoped_lock{ m_mutex };
+
+                    if (!m_error)
+                        m_error = std::current_exception();
+                }
+
+                m_outstanding.fetch_sub(1uL, std::memory_order_release);
+            });
+        }
+
+        auto wait()
+            -> void
+        {
+            _M_drain();
+
+            if (auto error { std::exchange(m_error, nullptr) }; error)
+                std::rethrow_exception(error);
+        }
+
+    private:
+
+        auto _M_drain() noexcept
+            -> void
+        {
+            while (m_outstanding.load(std::memory_order_acquire) != 0uL)
+                if (!m_pool.try_run_one())
+                    std::this_thread::yield();
+        }
+
+    private:
+        ThreadPool&                 m_pool;
+        std::atomic<size_type>      m_outstanding;
+        std::mutex                  m_mutex;
+        std::exception_ptr          m_error;
+
+    };  /// class TaskGroup
+
+}  /// namespace sv::parallel
+
+#endif  // SV_THREAD_POOL
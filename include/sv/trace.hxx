@@ -0,0 +1,771 @@
+#ifndef SV_TRACE
+#   define SV_TRACE
+
+#include <SFML/Graphics.hpp>
+
+#include <sv/colours.hxx>
+#include <sv/mapped_file.hxx>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace std::literals;
+
+/// Trace file layout (host endian):
+///
+///     header          64 bytes, see `trace_format`
+///     keyframe 0      state before the first event
+///     events...       one op byte + varint operands, with a keyframe
+///                     inlined every `keyframe_interval` events
+///     index           (event, offset) pair for every keyframe
+///
+/// Indices are zigzag varint deltas from the previous index and mark
+/// colours go through a small palette, so most events take 2-3 bytes.
+/// The palette and the previous index are reset at every keyframe so
+/// decoding can start from any keyframe.
+///
+/// Auxiliary reads and writes and comparisons of values read earlier
+/// (version 2) are logged so the counters replay exactly, but carry no
+/// index: the auxiliary lane is not recorded and stays blank on replay.
+namespace sv
+{
+    enum class TraceOp : std::uint8_t
+    {
+        READ, WRITE, COMPARE, SWAP,
+        MARK, UNMARK, MARK_RANGE, UNMARK_RANGE,
+        AUX_READ, AUX_WRITE, COMPARISONS,
+        KEYFRAME = 0x0F
+    };
+
+    struct TraceEvent
+    {
+        TraceOp         op;
+        std::size_t     first;
+        std::size_t     second;
+        float           value;
+        sf::Color       colour;
+    };
+
+    namespace trace_format
+    {
+        inline constexpr auto magic             = std::array{ 'S', 'V', 'T', 'R', 'A', 'C', 'E', '\0' };
+        inline constexpr auto version           = std::uint32_t{ 2u };
+        inline constexpr auto header_size       = std::size_t{ 64uL };
+        inline constexpr auto palette_size      = std::size_t{ 15uL };
+        inline constexpr auto literal_colour    = std::uint8_t{ 0x0Fu };
+
+        /// Byte offsets of the header fields.
+        inline constexpr auto version_offset    = std::size_t{ 8uL };
+        inline constexpr auto size_offset       = std::size_t{ 16uL };
+        inline constexpr auto interval_offset   = std::size_t{ 24uL };
+        inline constexpr auto events_offset     = std::size_t{ 32uL };
+        inline constexpr auto keyframes_offset  = std::size_t{ 40uL };
+        inline constexpr auto index_offset      = std::size_t{ 48uL };
+        inline constexpr auto max_value_offset  = std::size_t{ 56uL };
+
+        inline auto zigzag(std::uint64_t from, std::uint64_t to) noexcept
+            -> std::uint64_t
+        {
+            auto delta { static_cast<std::int64_t>(to - from) };
+            return (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63);
+        }
+
+        inline auto unzigzag(std::uint64_t from, std::uint64_t value) noexcept
+            -> std::uint64_t
+        { return from + ((value >> 1) ^ (~(value & 1uL) + 1uL)); }
+    }
+
+    /// The change an event logs when the caller made it already.
+    struct NoChange
+    {
+        constexpr auto operator() () const noexcept
+            -> void
+        { }
+    };
+
+    /// Writes a trace, from any number of sorting threads. Events that
+    /// change the items or their colours take the change itself and
+    /// apply it under the writer's lock, so a keyframe, which copies
+    /// both under that lock, never holds a change whose event is logged
+    /// after it, and never copies an element while it is written.
+    class TraceWriter
+    {
+    public:
+
+        using size_type         = std::size_t;
+        using element_type      = float;
+        using colour_type       = sf::Color;
+        using counters_type     = std::array<std::uint64_t, 4>;
+        using counters_fn       = std::function<counters_type()>;
+
+    public:
+
+        explicit TraceWriter(
+            const fs::path& path,
+            const std::vector<element_type>& items,
+            const Colours& colours,
+            element_type max_value,
+            counters_fn counters,
+            size_type keyframe_interval = size_type{}
+        )
+            : m_file{ path, std::ios::binary | std::ios::trunc }
+            , m_items{ items }
+            , m_colours{ colours }
+            , m_counters{ std::move(counters) }
+            , m_max_value{ max_value }
+            , m_interval{ keyframe_interval != size_type{}
+                ? keyframe_interval
+                : std::max(size_type{ 1uL << 16 }, 8uL * items.size()) }
+            , m_events{ std::uint64_t{} }
+            , m_offset{ trace_format::header_size }
+            , m_last{ std::uint64_t{} }
+            , m_buffer{ }
+            , m_palette{ }
+            , m_index{ }
+            , m_closed{ false }
+        {
+            if (!m_file)
+                throw std::runtime_error{ "Could not open trace `"s + path.string() + "` for writing."s };
+
+            auto header = std::array<char, trace_format::header_size>{};
+            m_file.write(header.data(), header.size());
+
+            m_buffer.reserve(s_flush_size + 64uL);
+            _M_keyframe();
+        }
+
+        TraceWriter(const TraceWriter&) = delete;
+        auto operator= (const TraceWriter&) -> TraceWriter& = delete;
+
+        ~TraceWriter() noexcept
+        {
+            try { close(); }
+            catch (...) { }
+        }
+
+        auto read(size_type idx) -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            _M_op(TraceOp::READ, idx);
+            _M_end_event();
+        }
+
+        template<std::invocable F = NoChange>
+        auto write(size_type idx, element_type value, F&& change = F{}) -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            change();
+            _M_op(TraceOp::WRITE, idx);
+            _M_put_u32(std::bit_cast<std::uint32_t>(value));
+            _M_end_event();
+        }
+
+        /// One write event per element of `in`, from `idx` on.
+        template<std::invocable F = NoChange>
+        auto write_block(size_type idx, std::span<const element_type> in, F&& change = F{}) -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            change();
+
+            for (auto i { 0uL }; i < in.size(); ++i)
+            {
+                _M_op(TraceOp::WRITE, idx + i);
+                _M_put_u32(std::bit_cast<std::uint32_t>(in[i]));
+                _M_end_event();
+            }
+        }
+
+        auto compare(size_type x, size_type y) -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            _M_op(TraceOp::COMPARE, x);
+            _M_put_varint(trace_format::zigzag(x, y));
+            _M_end_event();
+        }
+
+        auto aux_read() -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            m_buffer.push_back(static_cast<std::uint8_t>(TraceOp::AUX_READ));
+            _M_end_event();
+        }
+
+        auto aux_write() -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            m_buffer.push_back(static_cast<std::uint8_t>(TraceOp::AUX_WRITE));
+            _M_end_event();
+        }
+
+        /// `n` comparisons of values read earlier, as one event.
+        auto comparisons(size_type n) -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            m_buffer.push_back(static_cast<std::uint8_t>(TraceOp::COMPARISONS));
+            _M_put_varint(n);
+            _M_end_event();
+        }
+
+        template<std::invocable F = NoChange>
+        auto swap(size_type x, size_type y, F&& change = F{}) -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            change();
+            _M_op(TraceOp::SWAP, x);
+            _M_put_varint(trace_format::zigzag(x, y));
+            _M_end_event();
+        }
+
+        template<std::invocable F = NoChange>
+        auto mark(size_type idx, colour_type colour, F&& change = F{}) -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            change();
+            auto slot { _M_slot(colour) };
+            _M_op(TraceOp::MARK, idx, slot);
+            _M_put_colour(slot, colour);
+            _M_end_event();
+        }
+
+        template<std::invocable F = NoChange>
+        auto unmark(size_type idx, F&& change = F{}) -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            change();
+            _M_op(TraceOp::UNMARK, idx);
+            _M_end_event();
+        }
+
+        template<std::invocable F = NoChange>
+        auto mark_range(size_type fidx, size_type eidx, colour_type colour, F&& change = F{}) -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            change();
+            auto slot { _M_slot(colour) };
+            _M_op(TraceOp::MARK_RANGE, fidx, slot);
+            _M_put_varint(trace_format::zigzag(fidx, eidx));
+            _M_put_colour(slot, colour);
+            _M_end_event();
+        }
+
+        template<std::invocable F = NoChange>
+        auto unmark_range(size_type fidx, size_type eidx, F&& change = F{}) -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            change();
+            _M_op(TraceOp::UNMARK_RANGE, fidx);
+            _M_put_varint(trace_format::zigzag(fidx, eidx));
+            _M_end_event();
+        }
+
+        auto events() const noexcept
+            -> std::uint64_t
+        { return m_events; }
+
+        /// Writes the keyframe index and the final header. Further
+        /// events are ignored.
+        auto close() -> void
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+
+            if (m_closed)
+                return;
+
+            m_closed = true;
+            _M_flush();
+
+            auto index_offset { m_offset };
+            for (const auto& [event, offset] : m_index)
+            {
+                _M_put_u64(event);
+                _M_put_u64(offset);
+            }
+            _M_flush();
+
+            auto header = std::array<char, trace_format::header_size>{};
+            std::ranges::copy(trace_format::magic, header.begin());
+            _M_store(header, trace_format::version_offset, trace_format::version);
+            _M_store(header, trace_format::size_offset, static_cast<std::uint64_t>(m_items.size()));
+            _M_store(header, trace_format::interval_offset, static_cast<std::uint64_t>(m_interval));
+            _M_store(header, trace_format::events_offset, m_events);
+            _M_store(header, trace_format::keyframes_offset, static_cast<std::uint64_t>(m_index.size()));
+            _M_store(header, trace_format::index_offset, index_offset);
+            _M_store(header, trace_format::max_value_offset, m_max_value);
+
+            m_file.seekp(0);
+            m_file.write(header.data(), header.size());
+            m_file.close();
+        }
+
+    private:
+
+        static constexpr auto s_flush_size { 1uL << 20 };
+
+        template<typename T>
+        static auto _M_store(std::array<char, trace_format::header_size>& header, size_type offset, T value) noexcept
+            -> void
+        { std::memcpy(header.data() + offset, &value, sizeof(T)); }
+
+        auto _M_op(TraceOp op, size_type idx, std::uint8_t slot = std::uint8_t{})
+            -> void
+        {
+            m_buffer.push_back(static_cast<std::uint8_t>(static_cast<std::uint8_t>(op) | (slot << 4)));
+            _M_put_varint(trace_format::zigzag(m_last, idx));
+            m_last = idx;
+        }
+
+        auto _M_end_event()
+            -> void
+        {
+            if (m_closed)
+                return;
+
+            m_events += 1uL;
+
+            if (m_events % m_interval == 0uL)
+                _M_keyframe();
+
+            if (m_buffer.size() >= s_flush_size)
+                _M_flush();
+        }
+
+        /// Palette slot for `colour`, or the literal marker if it has to
+        /// be spelled out. Literals are appended to the palette while it
+        /// has room; the reader mirrors this exactly.
+        auto _M_slot(colour_type colour) noexcept
+            -> std::uint8_t
+        {
+            auto it { std::ranges::find(m_palette, colour) };
+            return it != m_palette.end()
+                ? static_cast<std::uint8_t>(it - m_palette.begin())
+                : trace_format::literal_colour;
+        }
+
+        auto _M_put_colour(std::uint8_t slot, colour_type colour)
+            -> void
+        {
+            if (slot != trace_format::literal_colour)
+                return;
+
+            m_buffer.insert(m_buffer.end(), { colour.r, colour.g, colour.b, colour.a });
+
+            if (m_palette.size() < trace_format::palette_size)
+                m_palette.push_back(colour);
+        }
+
+        auto _M_keyframe()
+            -> void
+        {
+            auto counters { m_counters ? m_counters() : counters_type{} };
+
+            m_index.emplace_back(m_events, m_offset + m_buffer.size());
+            m_buffer.push_back(static_cast<std::uint8_t>(TraceOp::KEYFRAME));
+            _M_put_u64(m_events);
+
+            for (auto c : counters)
+                _M_put_u64(c);
+
+            _M_flush();
+
+            /// Colours are stored next to the items even when the viewer
+            /// has fewer entries so the keyframe size only depends on N.
+            auto N { m_items.size() };
+            auto colours = std::vector<std::uint8_t>(N * 4uL, std::uint8_t{ 255u });
+            for (auto i { 0uL }; i < std::min(N, m_colours.size()); ++i)
+            {
+                auto c { m_colours.load(i) };
+                colours.at(i * 4uL)         = c.r;
+                colours.at(i * 4uL + 1uL)   = c.g;
+                colours.at(i * 4uL + 2uL)   = c.b;
+                colours.at(i * 4uL + 3uL)   = c.a;
+            }
+
+            m_file.write(reinterpret_cast<const char*>(m_items.data()), static_cast<std::streamsize>(N * sizeof(element_type)));
+            m_file.write(reinterpret_cast<const char*>(colours.data()), static_cast<std::streamsize>(colours.size()));
+            m_offset += N * sizeof(element_type) + colours.size();
+
+            m_palette.clear();
+            m_last = std::uint64_t{};
+        }
+
+        auto _M_put_varint(std::uint64_t value)
+            -> void
+        {
+            while (value >= 0x80u)
+            {
+                m_buffer.push_back(static_cast<std::uint8_t>(value | 0x80u));
+                value >>= 7;
+            }
+
+            m_buffer.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        auto _M_put_u32(std::uint32_t value)
+            -> void
+        {
+            auto bytes { std::bit_cast<std::array<std::uint8_t, 4>>(value) };
+            m_buffer.insert(m_buffer.end(), bytes.begin(), bytes.end());
+        }
+
+        auto _M_put_u64(std::uint64_t value)
+            -> void
+        {
+            auto bytes { std::bit_cast<std::array<std::uint8_t, 8>>(value) };
+            m_buffer.insert(m_buffer.end(), bytes.begin(), bytes.end());
+        }
+
+        auto _M_flush()
+            -> void
+        {
+            m_file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+            m_offset += m_buffer.size();
+            m_buffer.clear();
+        }
+
+    private:
+        std::mutex                                          m_mutex;
+        std::ofstream                                       m_file;
+        const std::vector<element_type>&                    m_items;
+        const Colours&                                      m_colours;
+        counters_fn                                         m_counters;
+        element_type                                        m_max_value;
+        size_type                                           m_interval;
+        std::uint64_t                                       m_events;
+        std::uint64_t                                       m_offset;
+        std::uint64_t                                       m_last;
+        std::vector<std::uint8_t>                           m_buffer;
+        std::vector<colour_type>                            m_palette;
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> m_index;
+        bool                                                m_closed;
+
+    };  /// class TraceWriter
+
+    /// Reads a trace through a read-only mapping. Every read is bounded
+    /// by the mapping, so a truncated or foreign file throws
+    /// `std::runtime_error` rather than reading past it.
+    class TraceReader
+    {
+    public:
+
+        using size_type         = std::size_t;
+        using element_type      = float;
+        using colour_type       = sf::Color;
+        using counters_type     = std::array<std::uint64_t, 4>;
+
+        struct Keyframe
+        {
+            std::uint64_t   event;
+            std::uint64_t   offset;
+        };
+
+        /// Decoding position inside the event stream.
+        struct Cursor
+        {
+            std::uint64_t               offset;
+            std::uint64_t               event;
+            std::uint64_t               last;
+            std::vector<colour_type>    palette;
+        };
+
+    public:
+
+        explicit TraceReader(const fs::path& path)
+            : m_file{ path }
+            , m_path{ path }
+        {
+            if (m_file.size() < trace_format::header_size
+             || !std::equal(trace_format::magic.begin(), trace_format::magic.end(), m_file.data()))
+                throw std::runtime_error{ "`"s + path.string() + "` is not a trace file."s };
+
+            /// Version 1 only lacks the auxiliary events.
+            if (auto v { _M_load<std::uint32_t>(trace_format::version_offset) }; v == 0u || v > trace_format::version)
+                throw std::runtime_error{ "`"s + path.string() + "` has an unsupported trace version."s };
+
+            m_size          = _M_load<std::uint64_t>(trace_format::size_offset);
+            m_interval      = _M_load<std::uint64_t>(trace_format::interval_offset);
+            m_events        = _M_load<std::uint64_t>(trace_format::events_offset);
+            m_keyframes     = _M_load<std::uint64_t>(trace_format::keyframes_offset);
+            m_index         = _M_load<std::uint64_t>(trace_format::index_offset);
+            m_max_value     = _M_load<element_type>(trace_format::max_value_offset);
+
+            if (m_keyframes == 0uL
+             || m_index > m_file.size()
+             || m_keyframes > (m_file.size() - m_index) / 16uL
+             || m_size > m_index / (sizeof(element_type) + 4uL))
+                _M_fail("is truncated.");
+
+            /// Every keyframe must fit before the index, so `load` never
+            /// has to check.
+            for (auto k { 0uL }; k < m_keyframes; ++k)
+                if (auto kf { _M_keyframe(k) }; kf.offset < trace_format::header_size || kf.offset > m_index || m_index - kf.offset < _M_keyframe_size())
+                    _M_fail("is truncated.");
+
+            m_file.advise(trace_format::header_size, m_file.size(), MADV_SEQUENTIAL);
+        }
+
+        auto path() const noexcept
+            -> const fs::path&
+        { return m_path; }
+
+        auto size() const noexcept
+            -> size_type
+        { return m_size; }
+
+        auto events() const noexcept
+            -> std::uint64_t
+        { return m_events; }
+
+        auto keyframe_interval() const noexcept
+            -> std::uint64_t
+        { return m_interval; }
+
+        auto max_value() const noexcept
+            -> element_type
+        { return m_max_value; }
+
+        /// Last keyframe at or before `step`.
+        auto keyframe_before(std::uint64_t step) const
+            -> Keyframe
+        {
+            auto lo { std::uint64_t{} };
+            auto hi { m_keyframes };
+
+            while (hi - lo > 1uL)
+            {
+                auto mid { lo + (hi - lo) / 2uL };
+                if (_M_keyframe(mid).event <= step)
+                    lo = mid;
+                else
+                    hi = mid;
+            }
+
+            return _M_keyframe(lo);
+        }
+
+        /// Restores the state stored at `kf` and returns a cursor that
+        /// decodes the events following it.
+        auto load(
+            const Keyframe& kf,
+            std::vector<element_type>& items,
+            Colours& colours,
+            counters_type& counters
+        ) const
+            -> Cursor
+        {
+            auto offset { kf.offset + 1uL + 8uL };
+
+            for (auto& c : counters)
+            {
+                c = _M_load<std::uint64_t>(offset);
+                offset += 8uL;
+            }
+
+            items.resize(m_size);
+            colours.assign(m_size, colour_type::White);
+
+            std::memcpy(items.data(), m_file.data() + offset, m_size * sizeof(element_type));
+            offset += m_size * sizeof(element_type);
+
+            for (auto i { 0uL }; i < m_size; ++i, offset += 4uL)
+            {
+                const auto* p { m_file.data() + offset };
+                colours.store(i, colour_type(p[0], p[1], p[2], p[3]));
+            }
+
+            return Cursor{ offset, kf.event, std::uint64_t{}, {} };
+        }
+
+        /// Decodes the event at `cursor` and advances it. Returns false
+        /// at the end of the trace and throws if the event runs past the
+        /// end of the event stream.
+        auto next(Cursor& cursor, TraceEvent& event) const
+            -> bool
+        {
+            if (cursor.event >= m_events)
+                return false;
+
+            auto header { _M_byte(cursor.offset) };
+
+            if (static_cast<TraceOp>(header & 0x0Fu) == TraceOp::KEYFRAME)
+            {
+                cursor.offset  += _M_keyframe_size();
+                cursor.last     = std::uint64_t{};
+                cursor.palette.clear();
+                header          = _M_byte(cursor.offset);
+            }
+
+            cursor.offset += 1uL;
+
+            auto slot { static_cast<std::uint8_t>(header >> 4) };
+            event.op        = static_cast<TraceOp>(header & 0x0Fu);
+
+            /// Counted only; `first` is how many, and the index deltas
+            /// carry on past them.
+            if (event.op == TraceOp::AUX_READ || event.op == TraceOp::AUX_WRITE || event.op == TraceOp::COMPARISONS)
+            {
+                event.first     = event.op == TraceOp::COMPARISONS ? _M_varint(cursor.offset) : 1uL;
+                event.second    = event.first;
+                cursor.event   += 1uL;
+                return true;
+            }
+
+            event.first     = trace_format::unzigzag(cursor.last, _M_varint(cursor.offset));
+            event.second    = event.first;
+            cursor.last     = event.first;
+
+            switch (event.op)
+            {
+                case TraceOp::READ:
+                case TraceOp::UNMARK:
+                    break;
+
+                case TraceOp::WRITE:
+                    event.value = std::bit_cast<element_type>(_M_load<std::uint32_t>(cursor.offset, m_index));
+                    cursor.offset += 4uL;
+                    break;
+
+                case TraceOp::COMPARE:
+                case TraceOp::SWAP:
+                case TraceOp::UNMARK_RANGE:
+                    event.second = trace_format::unzigzag(event.first, _M_varint(cursor.offset));
+                    break;
+
+                case TraceOp::MARK_RANGE:
+                    event.second = trace_format::unzigzag(event.first, _M_varint(cursor.offset));
+                    event.colour = _M_colour(cursor, slot);
+                    break;
+
+                case TraceOp::MARK:
+                    event.colour = _M_colour(cursor, slot);
+                    break;
+
+                default:
+                    _M_fail("is corrupt.");
+            }
+
+            cursor.event += 1uL;
+            return true;
+        }
+
+    private:
+
+        [[noreturn]] auto _M_fail(const char* what) const
+            -> void
+        { throw std::runtime_error{ "`"s + m_path.string() + "` "s + what }; }
+
+        /// Throws unless `n` bytes from `offset` lie before `end`.
+        auto _M_check(std::uint64_t offset, std::uint64_t n, std::uint64_t end) const
+            -> void
+        {
+            if (offset > end || end - offset < n)
+                _M_fail("is truncated.");
+        }
+
+        /// A `T` at `offset`, which must end by `end`.
+        template<typename T>
+        auto _M_load(std::uint64_t offset, std::uint64_t end) const
+            -> T
+        {
+            _M_check(offset, sizeof(T), end);
+
+            auto value = T{};
+            std::memcpy(&value, m_file.data() + offset, sizeof(T));
+            return value;
+        }
+
+        template<typename T>
+        auto _M_load(std::uint64_t offset) const
+            -> T
+        { return _M_load<T>(offset, m_file.size()); }
+
+        /// A byte of the event stream, which ends where the index starts.
+        auto _M_byte(std::uint64_t offset) const
+            -> std::uint8_t
+        {
+            _M_check(offset, 1uL, m_index);
+            return static_cast<std::uint8_t>(m_file.data()[offset]);
+        }
+
+        /// Op byte, event number, counters, items and colours.
+        auto _M_keyframe_size() const noexcept
+            -> std::uint64_t
+        { return 1uL + 8uL + 32uL + m_size * (sizeof(element_type) + 4uL); }
+
+        auto _M_keyframe(std::uint64_t k) const
+            -> Keyframe
+        {
+            return Keyframe{
+                _M_load<std::uint64_t>(m_index + k * 16uL),
+                _M_load<std::uint64_t>(m_index + k * 16uL + 8uL)
+            };
+        }
+
+        auto _M_varint(std::uint64_t& offset) const
+            -> std::uint64_t
+        {
+            auto value { std::uint64_t{} };
+            auto shift { 0u };
+            auto byte  { std::uint8_t{} };
+
+            do
+            {
+                byte = _M_byte(offset++);
+                value |= static_cast<std::uint64_t>(byte & 0x7Fu) << shift;
+                shift += 7u;
+            } while ((byte & 0x80u) != 0u && shift < 64u);
+
+            return value;
+        }
+
+        auto _M_colour(Cursor& cursor, std::uint8_t slot) const
+            -> colour_type
+        {
+            if (slot != trace_format::literal_colour)
+            {
+                if (slot >= cursor.palette.size())
+                    _M_fail("is corrupt.");
+
+                return cursor.palette[slot];
+            }
+
+            _M_check(cursor.offset, 4uL, m_index);
+
+            const auto* p { m_file.data() + cursor.offset };
+            auto colour = colour_type(p[0], p[1], p[2], p[3]);
+            cursor.offset += 4uL;
+
+            if (cursor.palette.size() < trace_format::palette_size)
+                cursor.palette.push_back(colour);
+
+            return colour;
+        }
+
+    private:
+        MappedFile          m_file;
+        fs::path            m_path;
+        size_type           m_size;
+        std::uint64_t       m_interval;
+        std::uint64_t       m_events;
+        std::uint64_t       m_keyframes;
+        std::uint64_t       m_index;
+        element_type        m_max_value;
+
+    };  /// class TraceReader
+
+}  /// namespace sv
+
+#endif  // SV_TRACE
@@ -3,9 +3,14 @@
 
 #include <SFML/Graphics.hpp>
 
+#include <sv/colours.hxx>
+#include <sv/dirty.hxx>
 #include <sv/elements.hxx>
+#include <sv/trace.hxx>
 
 #include <algorithm>
+#include <array>
+#include <limits>
 #include <memory>
 #include <ranges>
 #include <thread>
@@ -14,13 +19,21 @@
 
 namespace sv
 {
+    /// Draws the elements as bars from a single vertex buffer. Only bars
+    /// flagged in `DirtyBars` since the previous frame are rebuilt and
+    /// re-uploaded. When there are more elements than pixel columns each
+    /// column is downsampled to the min/max of the elements under it,
+    /// coloured by the most common mark, so frame time no longer grows
+    /// with the number of elements. A strip along the bottom shows the
+    /// auxiliary lane: whatever the algorithm currently holds in scratch
+    /// space, with its own marks.
     class Viewer : public sf::Sprite
     {
     public:
 
         using size_type     = std::size_t;
         using colour_type   = sf::Color;
-        using rect_type     = sf::RectangleShape;
+        using vertex_type   = sf::Vertex;
         using texture_type  = sf::RenderTexture;
 
     public:
@@ -33,16 +46,27 @@ namespace sv
             , m_texture{ texture_type{} }
             , m_elems { std::move(vw.m_elems) }
             , m_colours{ std::move(vw.m_colours) }
-            , m_rects{ std::move(vw.m_rects) }
-            , m_rect_width{ vw.m_rect_width }
+            , m_aux_colours{ std::move(vw.m_aux_colours) }
+            , m_vertices{ sf::VertexArray{ sf::Triangles } }
+            , m_aux_vertices{ sf::VertexArray{ sf::Triangles } }
+            , m_buffer{ sf::VertexBuffer{ sf::Triangles, sf::VertexBuffer::Stream } }
+            , m_dirty{ nullptr }
+            , m_aux_dirty{ nullptr }
+            , m_bar_width{ vw.m_bar_width }
+            , m_lane_height{ vw.m_lane_height }
+            , m_trace{ std::move(vw.m_trace) }
         {
             m_texture.create(
                 static_cast<unsigned int>(m_window_width),
                 static_cast<unsigned int>(m_window_height)
             );
+            this->setTexture(m_texture.getTexture());
+
+            if (m_window_width != size_type{})
+                _M_layout(m_colours.size());
 
             vw.m_texture.clear();
-            vw.m_rect_width = size_type{};
+            vw.m_bar_width = float{};
         }
 
         explicit Viewer(
@@ -54,11 +78,18 @@ namespace sv
             , m_window_height{ height }
             , m_texture{ texture_type{} }
             , m_elems{ elems }
-            , m_colours{ std::vector<colour_type>(elems->size(), colour_type::White) }
-            , m_rects{ std::vector<rect_type>(elems->size(), rect_type{}) }
-            , m_rect_width{ static_cast<float>(width) / static_cast<float>(elems->size()) }
+            , m_colours{ Colours(elems->size()) }
+            , m_aux_colours{ Colours(elems->size(), s_aux_colour) }
+            , m_vertices{ sf::VertexArray{ sf::Triangles } }
+            , m_aux_vertices{ sf::VertexArray{ sf::Triangles } }
+            , m_buffer{ sf::VertexBuffer{ sf::Triangles, sf::VertexBuffer::Stream } }
+            , m_dirty{ nullptr }
+            , m_aux_dirty{ nullptr }
+            , m_bar_width{ float{} }
+            , m_lane_height{ static_cast<float>(height) * s_lane_fraction }
+            , m_trace{ nullptr }
         {
-            _M_generate();
+            _M_layout(elems->size());
 
             m_texture.create(
                 static_cast<unsigned int>(m_window_width),
@@ -67,11 +98,33 @@ namespace sv
             this->setTexture(m_texture.getTexture());
         }
 
+        /// Headless viewer. Mark colours are still tracked so the
+        /// algorithms run unchanged but no render texture or vertices
+        /// are ever created.
+        explicit Viewer(std::shared_ptr<Elements> elems) noexcept
+            : m_window_width{ size_type{} }
+            , m_window_height{ size_type{} }
+            , m_texture{ texture_type{} }
+            , m_elems{ elems }
+            , m_colours{ Colours(elems->size()) }
+            , m_aux_colours{ Colours(elems->size(), s_aux_colour) }
+            , m_vertices{ sf::VertexArray{ sf::Triangles } }
+            , m_aux_vertices{ sf::VertexArray{ sf::Triangles } }
+            , m_buffer{ sf::VertexBuffer{ sf::Triangles, sf::VertexBuffer::Stream } }
+            , m_dirty{ nullptr }
+            , m_aux_dirty{ nullptr }
+            , m_bar_width{ float{} }
+            , m_lane_height{ float{} }
+            , m_trace{ nullptr }
+        { }
+
         ~Viewer() noexcept
         {
-            m_rect_width    = float{};
-            m_rects.clear();
+            m_bar_width     = float{};
+            m_vertices.clear();
+            m_aux_vertices.clear();
             m_colours.clear();
+            m_aux_colours.clear();
             m_texture.clear();
             m_window_height = size_type{};
             m_window_width  = size_type{};
@@ -80,84 +133,322 @@ namespace sv
         auto resize(size_type new_size)
             noexcept -> void
         {
-            m_rect_width = static_cast<float>(m_window_width) / static_cast<float>(new_size);
-            m_colours.resize(new_size);
-            m_rects.resize(new_size);
-            _M_generate();
+            m_colours.assign(new_size, colour_type::White);
+            m_aux_colours.assign(new_size, s_aux_colour);
+
+            if (m_window_width != size_type{})
+                _M_layout(new_size);
+
             unmark_range(0ul, new_size);
         }
 
-        auto render() 
+        auto render()
             noexcept -> void
         {
-            m_texture.clear();
+            if (!m_dirty)
+                return;
+
+            if (auto N { std::min(m_elems->items().size(), m_colours.size()) }; N != m_dirty->elements())
+                _M_layout(N);
 
-            for (auto i { 0uL }; i < m_rects.size(); ++i)
+            m_dirty->consume([this](size_type first, size_type last)
             {
-                auto h { m_elems->silent_read(i) };
-
-                m_rects.at(i).setSize(sf::Vector2f(m_rect_width - (m_rect_width * 0.1f), h));
-                m_rects.at(i).setPosition(
-                    static_cast<float>(i) * m_rect_width,
-                    static_cast<float>(m_window_height) - h
-                );
-                m_rects.at(i).setFillColor(m_colours.at(i));
-                m_texture.draw(m_rects.at(i));
-            }
+                for (auto b { first }; b < last; ++b)
+                    _M_build(b);
+
+                if (sf::VertexBuffer::isAvailable())
+                    m_buffer.update(
+                        &m_vertices[first * s_vertices_per_bar],
+                        (last - first) * s_vertices_per_bar,
+                        static_cast<unsigned int>(first * s_vertices_per_bar)
+                    );
+            });
 
+            m_aux_dirty->consume([this](size_type first, size_type last)
+            {
+                for (auto b { first }; b < last; ++b)
+                    _M_build_aux(b);
+            });
+
+            m_texture.clear();
+
+            if (sf::VertexBuffer::isAvailable())
+                m_texture.draw(m_buffer);
+            else
+                m_texture.draw(m_vertices);
+
+            m_texture.draw(m_aux_vertices);
             m_texture.display();
         }
 
         auto mark(size_type idx, colour_type colour)
             noexcept -> void
         {
-            if (idx > m_rects.size() - 1uL)
+            if (idx > m_colours.size() - 1uL)
                 return;
-            
-            m_colours.at(idx) = colour;
+
+            auto change = [&] { m_colours.store(idx, colour); };
+
+            if (m_trace)
+                m_trace->mark(idx, colour, change);
+            else
+                change();
+
+            touch(idx);
         }
 
         auto unmark(size_type idx)
             noexcept -> void
         {
-            if (idx > m_rects.size() - 1uL)
+            if (idx > m_colours.size() - 1uL)
                 return;
-            
-            m_colours.at(idx) = colour_type::White;
+
+            auto change = [&] { m_colours.store(idx, colour_type::White); };
+
+            if (m_trace)
+                m_trace->unmark(idx, change);
+            else
+                change();
+
+            touch(idx);
         }
 
         auto mark_range(size_type fidx, size_type eidx, colour_type colour)
             noexcept -> void
-        { std::ranges::fill(m_colours.begin() + fidx, m_colours.begin() + eidx, colour); }
+        {
+            auto change = [&] { m_colours.fill(fidx, eidx, colour); };
+
+            if (m_trace)
+                m_trace->mark_range(fidx, eidx, colour, change);
+            else
+                change();
+
+            touch_range(fidx, eidx);
+        }
 
         auto unmark_range(size_type fidx, size_type eidx)
             noexcept -> void
-        { std::ranges::fill(m_colours.begin() + fidx, m_colours.begin() + eidx, colour_type::White); }
+        {
+            auto change = [&] { m_colours.fill(fidx, eidx, colour_type::White); };
+
+            if (m_trace)
+                m_trace->unmark_range(fidx, eidx, change);
+            else
+                change();
+
+            touch_range(fidx, eidx);
+        }
+
+        /// Marks slot `idx` of the auxiliary lane.
+        auto aux_mark(size_type idx, colour_type colour)
+            noexcept -> void
+        {
+            if (idx >= m_aux_colours.size())
+                return;
+
+            m_aux_colours.store(idx, colour);
+
+            if (m_aux_dirty)
+                m_aux_dirty->touch(idx);
+        }
+
+        auto aux_unmark(size_type idx)
+            noexcept -> void
+        { aux_mark(idx, s_aux_colour); }
+
+        auto aux_mark_range(size_type fidx, size_type eidx, colour_type colour)
+            noexcept -> void
+        {
+            eidx = std::min(eidx, m_aux_colours.size());
+
+            if (fidx >= eidx)
+                return;
+
+            m_aux_colours.fill(fidx, eidx, colour);
+
+            if (m_aux_dirty)
+                m_aux_dirty->touch_range(fidx, eidx);
+        }
+
+        auto aux_unmark_range(size_type fidx, size_type eidx)
+            noexcept -> void
+        { aux_mark_range(fidx, eidx, s_aux_colour); }
+
+        /// Flags elements that were changed behind the viewer's back
+        /// (eg. written directly through `Elements::items()`) for redraw.
+        auto touch(size_type idx) noexcept
+            -> void
+        {
+            if (m_dirty)
+                m_dirty->touch(idx);
+        }
+
+        auto touch_range(size_type fidx, size_type eidx) noexcept
+            -> void
+        {
+            if (m_dirty)
+                m_dirty->touch_range(fidx, eidx);
+        }
+
+        auto touch_all() noexcept
+            -> void
+        {
+            if (m_dirty)
+                m_dirty->touch_all();
+        }
+
+        auto colours() noexcept
+            -> Colours&
+        { return m_colours; }
+
+        /// Records every subsequent mark into `trace`. Pass `nullptr`
+        /// to stop recording.
+        auto trace(std::shared_ptr<TraceWriter> trace) noexcept
+            -> void
+        { m_trace = std::move(trace); }
 
     private:
 
-        auto _M_generate()
+        /// Two quads per bar: the solid body up to the smallest element
+        /// under the bar and a dimmer band from there to the largest.
+        /// Without downsampling the band is empty.
+        static constexpr auto s_vertices_per_bar { 12uL };
+        static constexpr auto s_max_mark_colours { 4uL };
+        static constexpr auto s_aux_vertices_per_bar { 6uL };
+
+        /// Share of the height given to the auxiliary lane, and the colour
+        /// of unmarked auxiliary slots.
+        static constexpr auto s_lane_fraction { 0.1f };
+        inline static const auto s_aux_colour { colour_type{ 110u, 140u, 200u } };
+
+        auto _M_layout(size_type N)
             noexcept -> void
         {
-            std::ranges::fill(m_rects, rect_type(sf::Vector2f(m_rect_width - (m_rect_width * 0.1f), 0.0f)));
-            std::ranges::for_each(
-                m_rects,
-                [this](auto& r)
-                {   
-                    r.setOutlineThickness(m_rect_width * 0.1f);
-                    r.setOutlineColor(sf::Color::Black);
+            auto bars { std::min(N, m_window_width) };
+
+            m_bar_width = bars != size_type{}
+                ? static_cast<float>(m_window_width) / static_cast<float>(bars)
+                : float{};
+
+            m_vertices.resize(bars * s_vertices_per_bar);
+
+            if (sf::VertexBuffer::isAvailable())
+                m_buffer.create(bars * s_vertices_per_bar);
+
+            m_dirty = std::make_shared<DirtyBars>(N, bars);
+            m_elems->watch(m_dirty);
+
+            m_aux_vertices.resize(bars * s_aux_vertices_per_bar);
+            m_aux_dirty = std::make_shared<DirtyBars>(N, bars);
+            m_elems->scratch().watch(m_aux_dirty);
+        }
+
+        auto _M_build(size_type b)
+            noexcept -> void
+        {
+            const auto& items   = m_elems->items();
+            auto first          { m_dirty->first(b) };
+            auto last           { std::min(m_dirty->first(b + 1uL), items.size()) };
+
+            auto lo { std::numeric_limits<float>::max() };
+            auto hi { std::numeric_limits<float>::lowest() };
+            auto marks = std::array<std::pair<colour_type, size_type>, s_max_mark_colours>{};
+            auto nmarks { 0uL };
+
+            for (auto i { first }; i < last; ++i)
+            {
+                auto h { items[i] };
+                lo = std::min(lo, h);
+                hi = std::max(hi, h);
+
+                if (auto c { m_colours.load(i) }; c != colour_type::White)
+                {
+                    auto it { std::find_if(marks.begin(), marks.begin() + nmarks, [&c](const auto& m) { return m.first == c; }) };
+
+                    if (it != marks.begin() + nmarks)
+                        it->second += 1uL;
+                    else if (nmarks < s_max_mark_colours)
+                        marks.at(nmarks++) = std::pair{ c, 1uL };
                 }
-            );
+            }
+
+            if (first >= last)
+                lo = hi = 0.0f;
+
+            auto colour { colour_type::White };
+            if (nmarks != 0uL)
+                colour = std::max_element(
+                    marks.begin(),
+                    marks.begin() + nmarks,
+                    [](const auto& x, const auto& y) { return x.second < y.second; }
+                )->first;
+
+            auto band { colour };
+            band.a = 110u;
+
+            auto x0     { static_cast<float>(b) * m_bar_width };
+            auto x1     { x0 + (last - first > 1uL ? m_bar_width : m_bar_width - (m_bar_width * 0.1f)) };
+            auto base   { static_cast<float>(m_window_height) - m_lane_height };
+            auto scale  { base / static_cast<float>(m_window_height) };
+
+            _S_quad(m_vertices, b * s_vertices_per_bar, x0, x1, base - lo * scale, base, colour);
+            _S_quad(m_vertices, b * s_vertices_per_bar + 6uL, x0, x1, base - hi * scale, base - lo * scale, band);
+        }
+
+        /// One quad per bar for the tallest auxiliary value under it, in
+        /// the colour of its first marked slot.
+        auto _M_build_aux(size_type b)
+            noexcept -> void
+        {
+            const auto& lane    = m_elems->scratch().lane();
+            auto first          { m_aux_dirty->first(b) };
+            auto last           { std::min({ m_aux_dirty->first(b + 1uL), lane.size(), m_aux_colours.size() }) };
+
+            auto hi     { 0.0f };
+            auto colour { s_aux_colour };
+
+            for (auto i { first }; i < last; ++i)
+            {
+                hi = std::max(hi, lane[i].load(std::memory_order_relaxed));
+
+                if (colour == s_aux_colour)
+                    colour = m_aux_colours.load(i);
+            }
+
+            auto x0     { static_cast<float>(b) * m_bar_width };
+            auto x1     { x0 + (last - first > 1uL ? m_bar_width : m_bar_width - (m_bar_width * 0.1f)) };
+            auto base   { static_cast<float>(m_window_height) };
+            auto h      { m_elems->max_value() > 0.0f ? hi / m_elems->max_value() * (m_lane_height - 2.0f) : 0.0f };
+
+            _S_quad(m_aux_vertices, b * s_aux_vertices_per_bar, x0, x1, base - h, base, colour);
+        }
+
+        static auto _S_quad(sf::VertexArray& vertices, size_type v, float x0, float x1, float y0, float y1, colour_type colour)
+            noexcept -> void
+        {
+            vertices[v]         = vertex_type(sf::Vector2f(x0, y0), colour);
+            vertices[v + 1uL]   = vertex_type(sf::Vector2f(x1, y0), colour);
+            vertices[v + 2uL]   = vertex_type(sf::Vector2f(x0, y1), colour);
+            vertices[v + 3uL]   = vertex_type(sf::Vector2f(x0, y1), colour);
+            vertices[v + 4uL]   = vertex_type(sf::Vector2f(x1, y0), colour);
+            vertices[v + 5uL]   = vertex_type(sf::Vector2f(x1, y1), colour);
         }
 
     private:
-        size_type                   m_window_width;
-        size_type                   m_window_height;
-        texture_type                m_texture;
-        std::shared_ptr<Elements>   m_elems;
-        std::vector<colour_type>    m_colours;
-        std::vector<rect_type>      m_rects;
-        float                       m_rect_width;
+        size_type                       m_window_width;
+        size_type                       m_window_height;
+        texture_type                    m_texture;
+        std::shared_ptr<Elements>       m_elems;
+        Colours                         m_colours;
+        Colours                         m_aux_colours;
+        sf::VertexArray                 m_vertices;
+        sf::VertexArray                 m_aux_vertices;
+        sf::VertexBuffer                m_buffer;
+        std::shared_ptr<DirtyBars>      m_dirty;
+        std::shared_ptr<DirtyBars>      m_aux_dirty;
+        float                           m_bar_width;
+        float                           m_lane_height;
+        std::shared_ptr<TraceWriter>    m_trace;
     };  /// class Viewer
 
 }  /// namespace sv
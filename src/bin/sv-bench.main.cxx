@@ -0,0 +1,726 @@
+#include <sv/elements.hxx>
+#include <sv/inputs.hxx>
+#include <sv/keys.hxx>
+#include <sv/perf.hxx>
+#include <sv/registry.hxx>
+#include <sv/sorter.hxx>
+#include <sv/thread_pool.hxx>
+#include <sv/viewer.hxx>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+using namespace std::literals;
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    /// A 64-bit key with a 24 byte payload, the first word of which holds
+    /// the record's position in the sorted ramp.
+    using record_type = sv::Record<std::uint64_t, std::array<std::uint64_t, 3uL>>;
+
+    inline constexpr auto element_types = std::array{
+        "f32"sv, "f64"sv, "u32"sv, "u64"sv, "record"sv, "record-soa"sv
+    };
+
+    struct Options
+    {
+        std::vector<std::string>        algorithms;
+        std::vector<std::size_t>        sizes       { 1'000uL, 10'000uL, 100'000uL, 1'000'000uL, 10'000'000uL };
+        std::vector<sv::InputShape>     shapes      { sv::input_shapes.begin(), sv::input_shapes.end() };
+        std::size_t                     repeats     { 5uL };
+        std::uint64_t                   seed        { 42uL };
+        std::vector<std::string>        modes       { "instrumented"s, "native"s };
+        std::vector<std::string>        types       { "f32"s };
+        std::string                     format      { "csv"s };
+        std::string                     output      { };
+        double                          budget      { 10.0 };
+        bool                            list        { false };
+        bool                            phases      { false };
+    };
+
+    struct Result
+    {
+        std::string     algorithm;
+        std::string     mode;
+        std::string     type;
+        std::string     shape;
+        std::size_t     size;
+        std::size_t     runs;
+        double          median_ns;
+        double          p95_ns;
+        double          ns_per_element;
+        std::size_t     comparisons;
+        std::size_t     reads;
+        std::size_t     writes;
+        std::size_t     swaps;
+        std::size_t     aux_peak_bytes;
+        std::size_t     aux_allocations;
+        sv::PerfCounts  counters;
+        std::array<sv::PerfCounts, sv::perf_phases.size()> phases;
+        bool            sorted;
+    };
+
+    auto usage() -> void
+    {
+        std::clog << "Usage: sv-bench [options]\n"
+                  << "  --algorithms A,B,...   Algorithms to run (default: all, plus std::sort and std::stable_sort)\n"
+                  << "  --sizes N,M,...        Element counts (default: 1000,10000,100000,1000000,10000000)\n"
+                  << "  --shapes S,T,...       random, sorted, reversed, few-unique, sawtooth (default: all)\n"
+                  << "  --repeats R            Timed runs per data point (default: 5)\n"
+                  << "  --seed S               Seed for the input shapes (default: 42)\n"
+                  << "  --mode M               instrumented, native or both (default: both)\n"
+                  << "  --types T,U,...        f32, f64, u32, u64, record, record-soa (default: f32)\n"
+                  << "  --budget SECONDS       Skip sizes predicted to take longer than this per run (default: 10)\n"
+                  << "  --format csv|json      Output format (default: csv)\n"
+                  << "  --output FILE          Write results to FILE instead of stdout\n"
+                  << "  --phases               Also count each algorithm phase (JSON only, adds overhead)\n"
+                  << "  --list                 List the available algorithms and exit\n";
+    }
+
+    auto split(std::string_view str, char delim)
+        -> std::vector<std::string>
+    {
+        auto parts = std::vector<std::string>{};
+
+        for (auto part : str | std::views::split(delim))
+            if (auto s = std::string(part.begin(), part.end()); !s.empty())
+                parts.push_back(s);
+
+        return parts;
+    }
+
+    auto parse_options(int argc, char* argv[])
+        -> std::optional<Options>
+    {
+        auto opts = Options{};
+
+        for (auto i { 1 }; i < argc; ++i)
+        {
+            auto arg = std::string_view{ argv[i] };
+
+            if (arg == "--list"sv)
+            {
+                opts.list = true;
+                continue;
+            }
+
+            if (arg == "--phases"sv)
+            {
+                opts.phases = true;
+                continue;
+            }
+
+            if (arg == "--help"sv || arg == "-h"sv || i + 1 == argc)
+                return std::nullopt;
+
+            auto value = std::string_view{ argv[++i] };
+
+            try
+            {
+                if (arg == "--algorithms"sv)
+                    opts.algorithms = split(value, ',');
+                else if (arg == "--sizes"sv)
+                {
+                    opts.sizes.clear();
+                    for (const auto& s : split(value, ','))
+                        if (auto N { std::stoul(s) }; N != 0uL)
+                            opts.sizes.push_back(N);
+                        else
+                        {
+                            std::clog << "Sizes must be at least 1." << std::endl;
+                            return std::nullopt;
+                        }
+                }
+                else if (arg == "--shapes"sv)
+                {
+                    opts.shapes.clear();
+                    for (const auto& s : split(value, ','))
+                        if (auto shape { sv::parse_shape(s) }; shape)
+                            opts.shapes.push_back(*shape);
+                        else
+                        {
+                            std::clog << "Unknown input shape `" << s << "`." << std::endl;
+                            return std::nullopt;
+                        }
+                }
+                else if (arg == "--repeats"sv)
+                    opts.repeats = std::max(std::stoul(std::string(value)), 1uL);
+                else if (arg == "--seed"sv)
+                    opts.seed = std::stoull(std::string(value));
+                else if (arg == "--mode"sv && (value == "instrumented"sv || value == "native"sv))
+                    opts.modes = { std::string{ value } };
+                else if (arg == "--mode"sv && value == "both"sv)
+                    opts.modes = { "instrumented"s, "native"s };
+                else if (arg == "--types"sv)
+                {
+                    opts.types.clear();
+                    for (const auto& t : split(value, ','))
+                        if (std::ranges::find(element_types, t) != element_types.end())
+                            opts.types.push_back(t);
+                        else
+                        {
+                            std::clog << "Unknown element type `" << t << "`." << std::endl;
+                            return std::nullopt;
+                        }
+                }
+                else if (arg == "--budget"sv)
+                    opts.budget = std::stod(std::string(value));
+                else if (arg == "--format"sv && (value == "csv"sv || value == "json"sv))
+                    opts.format = value;
+                else if (arg == "--output"sv)
+                    opts.output = value;
+                else
+                    return std::nullopt;
+            }
+            catch (const std::exception&)
+            {
+                std::clog << "Invalid value `" << value << "` for " << arg << "." << std::endl;
+                return std::nullopt;
+            }
+        }
+
+        std::ranges::sort(opts.sizes);
+        return opts;
+    }
+
+    auto median(const std::vector<double>& sorted_samples) noexcept
+        -> double
+    {
+        auto n { sorted_samples.size() };
+        return n % 2uL == 1uL
+            ? sorted_samples.at(n / 2uL)
+            : (sorted_samples.at(n / 2uL - 1uL) + sorted_samples.at(n / 2uL)) / 2.0;
+    }
+
+    /// Nearest-rank percentile.
+    auto percentile(const std::vector<double>& sorted_samples, double p) noexcept
+        -> double
+    {
+        auto rank { static_cast<std::size_t>(std::ceil(p * static_cast<double>(sorted_samples.size()))) };
+        return sorted_samples.at(std::clamp(rank, 1uL, sorted_samples.size()) - 1uL);
+    }
+
+    /// Median of each event over the runs, so one noisy run does not
+    /// skew a column.
+    auto median_counts(const std::vector<sv::PerfCounts>& runs)
+        -> sv::PerfCounts
+    {
+        if (runs.empty())
+            return sv::PerfCounts{};
+
+        auto counts { runs.front() };
+        auto values = std::vector<double>(runs.size());
+
+        for (auto e { 0uL }; e < counts.values.size(); ++e)
+        {
+            std::ranges::transform(runs, values.begin(), [e](const auto& run) { return static_cast<double>(run.values[e]); });
+            std::ranges::sort(values);
+            counts.values[e] = static_cast<sv::PerfCounts::value_type>(median(values));
+        }
+
+        return counts;
+    }
+
+    /// Extrapolates the next run time from the growth seen so far so
+    /// quadratic algorithms stop before they run for hours.
+    auto predict_seconds(const std::vector<std::pair<std::size_t, double>>& history, std::size_t n) noexcept
+        -> double
+    {
+        if (history.empty())
+            return 0.0;
+
+        auto exponent { 2.0 };
+        const auto& [n1, t1] = history.back();
+
+        if (history.size() > 1uL)
+        {
+            const auto& [n0, t0] = history.at(history.size() - 2uL);
+            if (t0 > 0.0 && t1 > 0.0)
+                exponent = std::clamp(
+                    std::log(t1 / t0) / std::log(static_cast<double>(n1) / static_cast<double>(n0)),
+                    1.0,
+                    2.5
+                );
+        }
+
+        return t1 * std::pow(static_cast<double>(n) / static_cast<double>(n1), exponent);
+    }
+
+    auto escape(std::string_view str)
+        -> std::string
+    {
+        auto out = std::string{};
+
+        for (auto c : str)
+        {
+            if (c == '"' || c == '\\')
+                out += '\\';
+            out += c;
+        }
+
+        return out;
+    }
+
+    /// An event's count, or nothing if the source could not count it.
+    auto csv_count(const sv::PerfCounts& counts, sv::PerfEvent event)
+        -> std::string
+    { return counts.has(event) ? std::to_string(counts[event]) : ""s; }
+
+    /// Counted events as JSON members, uncounted ones as null.
+    auto json_counts(std::ostream& os, const sv::PerfCounts& counts)
+        -> void
+    {
+        for (auto event : sv::perf_events)
+        {
+            os << ", \"" << sv::event_name(event) << "\": ";
+
+            if (counts.has(event))
+                os << counts[event];
+            else
+                os << "null";
+        }
+    }
+
+    auto write_csv(std::ostream& os, const std::vector<Result>& results)
+        -> void
+    {
+        os << "algorithm,mode,type,shape,size,runs,median_ns,p95_ns,ns_per_element,comparisons,reads,writes,swaps,aux_peak_bytes,aux_allocations,"
+           << "counter_source,cpu_ns,cycles,instructions,ipc,l1d_misses,llc_misses,branch_misses,page_faults,context_switches,sorted\n";
+
+        for (const auto& r : results)
+        {
+            os << '"' << escape(r.algorithm) << "\","
+               << r.mode << ','
+               << r.type << ','
+               << r.shape << ','
+               << r.size << ','
+               << r.runs << ','
+               << std::fixed << std::setprecision(0) << r.median_ns << ','
+               << r.p95_ns << ','
+               << std::setprecision(3) << r.ns_per_element << ','
+               << r.comparisons << ','
+               << r.reads << ','
+               << r.writes << ','
+               << r.swaps << ','
+               << r.aux_peak_bytes << ','
+               << r.aux_allocations << ','
+               << sv::source_name(r.counters.source) << ','
+               << csv_count(r.counters, sv::PerfEvent::CPU_TIME) << ','
+               << csv_count(r.counters, sv::PerfEvent::CYCLES) << ','
+               << csv_count(r.counters, sv::PerfEvent::INSTRUCTIONS) << ',';
+
+            if (r.counters.has(sv::PerfEvent::CYCLES) && r.counters.has(sv::PerfEvent::INSTRUCTIONS))
+                os << std::setprecision(3) << r.counters.ipc();
+
+            os << ',' << csv_count(r.counters, sv::PerfEvent::L1D_MISSES) << ','
+               << csv_count(r.counters, sv::PerfEvent::LLC_MISSES) << ','
+               << csv_count(r.counters, sv::PerfEvent::BRANCH_MISSES) << ','
+               << csv_count(r.counters, sv::PerfEvent::PAGE_FAULTS) << ','
+               << csv_count(r.counters, sv::PerfEvent::CONTEXT_SWITCHES) << ','
+               << (r.sorted ? "true" : "false") << '\n';
+        }
+    }
+
+    auto write_json(std::ostream& os, const std::vector<Result>& results, bool phases)
+        -> void
+    {
+        os << "[\n";
+
+        for (auto i { 0uL }; i < results.size(); ++i)
+        {
+            const auto& r { results.at(i) };
+
+            os << "  { \"algorithm\": \"" << escape(r.algorithm) << "\""
+               << ", \"mode\": \"" << r.mode << "\""
+               << ", \"type\": \"" << r.type << "\""
+               << ", \"shape\": \"" << r.shape << "\""
+               << ", \"size\": " << r.size
+               << ", \"runs\": " << r.runs
+               << std::fixed << std::setprecision(0)
+               << ", \"median_ns\": " << r.median_ns
+               << ", \"p95_ns\": " << r.p95_ns
+               << std::setprecision(3)
+               << ", \"ns_per_element\": " << r.ns_per_element
+               << ", \"comparisons\": " << r.comparisons
+               << ", \"reads\": " << r.reads
+               << ", \"writes\": " << r.writes
+               << ", \"swaps\": " << r.swaps
+               << ", \"aux_peak_bytes\": " << r.aux_peak_bytes
+               << ", \"aux_allocations\": " << r.aux_allocations
+               << ", \"counter_source\": \"" << sv::source_name(r.counters.source) << "\"";
+
+            json_counts(os, r.counters);
+
+            if (r.counters.has(sv::PerfEvent::CYCLES) && r.counters.has(sv::PerfEvent::INSTRUCTIONS))
+                os << ", \"ipc\": " << r.counters.ipc();
+            else
+                os << ", \"ipc\": null";
+
+            if (phases)
+            {
+                os << ", \"phases\": {";
+
+                for (auto phase : sv::perf_phases)
+                {
+                    os << (phase == sv::perf_phases.front() ? " \"" : ", \"") << sv::phase_name(phase) << "\": { \"share\": "
+                       << static_cast<double>(r.phases[static_cast<std::size_t>(phase)][sv::PerfEvent::CPU_TIME])
+                        / static_cast<double>(std::max(r.counters[sv::PerfEvent::CPU_TIME], 1uL));
+
+                    json_counts(os, r.phases[static_cast<std::size_t>(phase)]);
+                    os << " }";
+                }
+
+                os << " }";
+            }
+
+            os << ", \"sorted\": " << (r.sorted ? "true" : "false")
+               << " }" << (i + 1uL == results.size() ? "\n" : ",\n");
+        }
+
+        os << "]\n";
+    }
+
+    template<typename T>
+    auto element(float value, std::size_t idx)
+        -> T
+    {
+        if constexpr (sv::is_record_v<T>)
+            return T{ static_cast<typename T::key_type>(value), typename T::payload_type{ idx } };
+        else
+            return static_cast<T>(value);
+    }
+
+    /// A plain array of `T`: scalars, or records laid out as an array of
+    /// structures.
+    template<typename T>
+    struct ArrayStore
+    {
+        using access_type = sv::NativeAccess<T>;
+
+        std::vector<T>  items;
+
+        explicit ArrayStore(const std::vector<float>& input)
+            : items(input.size())
+        {
+            for (auto i { 0uL }; i < input.size(); ++i)
+                items[i] = element<T>(input[i], i);
+        }
+
+        auto access() -> access_type
+        { return access_type{ items }; }
+
+        auto sorted() const -> bool
+        { return std::ranges::is_sorted(items); }
+    };
+
+    /// Records laid out as a structure of arrays.
+    template<typename R>
+    struct SplitStore
+    {
+        using access_type = sv::SoaAccess<typename R::key_type, typename R::payload_type>;
+
+        std::vector<typename R::key_type>       keys;
+        std::vector<typename R::payload_type>   payloads;
+
+        explicit SplitStore(const std::vector<float>& input)
+            : keys(input.size())
+            , payloads(input.size())
+        {
+            for (auto i { 0uL }; i < input.size(); ++i)
+            {
+                auto record { element<R>(input[i], i) };
+                keys[i]     = record.key;
+                payloads[i] = record.payload;
+            }
+        }
+
+        auto access() -> access_type
+        { return access_type{ keys, payloads }; }
+
+        auto sorted() const -> bool
+        { return std::ranges::is_sorted(keys); }
+    };
+
+    /// Calls `f.template operator()<Store>()` with the store for `type`.
+    template<typename F>
+    auto with_store(std::string_view type, F&& f)
+    {
+        if (type == "f64"sv)
+            return f.template operator()<ArrayStore<double>>();
+        if (type == "u32"sv)
+            return f.template operator()<ArrayStore<std::uint32_t>>();
+        if (type == "u64"sv)
+            return f.template operator()<ArrayStore<std::uint64_t>>();
+        if (type == "record"sv)
+            return f.template operator()<ArrayStore<record_type>>();
+        if (type == "record-soa"sv)
+            return f.template operator()<SplitStore<record_type>>();
+
+        return f.template operator()<ArrayStore<float>>();
+    }
+
+    /// The native registry for `Store`, plus the standard library
+    /// baselines where the layout is one contiguous range.
+    template<typename Store>
+    auto native_algorithms()
+        -> sv::native_map_type<typename Store::access_type>
+    {
+        using access_type = typename Store::access_type;
+
+        auto native = sv::native_algorithms<access_type>();
+
+        if constexpr (requires (access_type& a) { a.items(); })
+        {
+            native.emplace("std::sort"s, [](access_type& a) { std::ranges::sort(a.items()); });
+            native.emplace("std::stable_sort"s, [](access_type& a) { std::ranges::stable_sort(a.items()); });
+        }
+
+        return native;
+    }
+
+    /// Sorts a fresh `Store` built from `input` with `name`, counting it
+    /// with `perf`. Building the store is not timed. Returns the wall time
+    /// in ns and whether the result is sorted.
+    template<typename Store>
+    auto time_native(const std::string& name, const std::vector<float>& input, sv::PerfCounters& perf, bool phases)
+        -> std::pair<double, bool>
+    {
+        auto sort   { native_algorithms<Store>().at(name) };
+        auto store  = Store{ input };
+        auto access { store.access() };
+
+        perf.start(sv::parallel::pool().threads(), phases);
+        auto start { clock_type::now() };
+        sort(access);
+        auto end { clock_type::now() };
+        perf.stop();
+
+        return { static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()), store.sorted() };
+    }
+}
+
+auto main(int argc, char* argv[]) -> int
+{
+    auto opts { parse_options(argc, argv) };
+
+    if (!opts)
+    {
+        usage();
+        return 1;
+    }
+
+    auto map = sv::default_algorithms();
+
+    map.emplace("std::sort"s, std::tuple{
+        ""s,
+        std::vector<std::string>{},
+        sv::Sorter::function_type{
+            [](std::shared_ptr<sv::Elements> elems, std::shared_ptr<sv::Viewer>)
+            { std::ranges::sort(elems->items()); }
+        }
+    });
+
+    map.emplace("std::stable_sort"s, std::tuple{
+        ""s,
+        std::vector<std::string>{},
+        sv::Sorter::function_type{
+            [](std::shared_ptr<sv::Elements> elems, std::shared_ptr<sv::Viewer>)
+            { std::ranges::stable_sort(elems->items()); }
+        }
+    });
+
+    if (opts->algorithms.empty())
+    {
+        auto names = map | std::views::keys;
+        opts->algorithms.assign(names.begin(), names.end());
+        std::ranges::sort(opts->algorithms);
+    }
+
+    if (opts->list)
+    {
+        std::ranges::copy(opts->algorithms, std::ostream_iterator<std::string>(std::cout, "\n"));
+        return 0;
+    }
+
+    for (const auto& name : opts->algorithms)
+        if (map.find(name) == map.cend())
+        {
+            std::clog << "Could not find algorithm `" << name << "`. Use --list to see the available algorithms." << std::endl;
+            return 1;
+        }
+
+    auto results = std::vector<Result>{};
+
+    for (const auto& name : opts->algorithms)
+    {
+        for (const auto& type : opts->types)
+        {
+            for (const auto& mode : opts->modes)
+            {
+                /// Instrumented runs go through `Elements` and `Viewer` like the
+                /// visualizer does, so only over its floats; native runs sort
+                /// plain arrays of `type` with the same algorithm compiled over
+                /// `NativeAccess` or `SoaAccess`.
+                auto instrumented { mode == "instrumented"s };
+                const auto& algorithm { std::get<2>(map.at(name)) };
+
+                if (instrumented && type != "f32"s)
+                {
+                    std::clog << name << " (" << mode << ") / " << type << ": skipping, instrumented runs only sort f32" << std::endl;
+                    continue;
+                }
+
+                if (!instrumented && !with_store(type, [&]<typename Store>() { return native_algorithms<Store>().contains(name); }))
+                {
+                    std::clog << name << " (" << mode << ") / " << type << ": skipping, not available for this layout" << std::endl;
+                    continue;
+                }
+
+                for (auto shape : opts->shapes)
+                {
+                    auto history = std::vector<std::pair<std::size_t, double>>{};
+
+                    for (auto N : opts->sizes)
+                    {
+                        if (auto predicted { predict_seconds(history, N) }; predicted > opts->budget)
+                        {
+                            std::clog << name << " (" << mode << ") / " << type << " / " << sv::shape_name(shape) << ": skipping N >= " << N
+                                      << " (predicted " << predicted << " s per run)" << std::endl;
+                            break;
+                        }
+
+                        /// Values are the same ramp the visualizer draws, scaled to
+                        /// N and rounded so integer-keyed sorts (radix, counting)
+                        /// see the same keys as the comparison sorts, and every
+                        /// element type sorts the same sequence of keys.
+                        auto elems = std::make_shared<sv::Elements>(
+                            static_cast<sv::Elements::element_type>(N),
+                            N,
+                            nullptr,
+                            nullptr
+                        );
+                        elems->generate(shape, opts->seed);
+                        std::ranges::transform(elems->items(), elems->items().begin(), [](auto v) { return std::round(v); });
+
+                        auto input = elems->items();
+                        auto viewer = std::make_shared<sv::Viewer>(elems);
+                        auto samples = std::vector<double>{};
+                        auto sorted { true };
+                        auto& scratch { instrumented ? elems->scratch() : sv::native_scratch() };
+                        auto perf = sv::PerfCounters{};
+                        auto counts = std::vector<sv::PerfCounts>{};
+                        auto phases = std::array<std::vector<sv::PerfCounts>, sv::perf_phases.size()>{};
+
+                        for (auto r { 0uL }; r < opts->repeats; ++r)
+                        {
+                            elems->items() = input;
+                            elems->reset_counters();
+                            viewer->unmark_range(0uL, N);
+                            scratch.reset_stats();
+
+                            if (instrumented)
+                            {
+                                perf.start(sv::parallel::pool().threads(), opts->phases);
+                                auto start { clock_type::now() };
+                                algorithm(elems, viewer);
+                                auto end { clock_type::now() };
+                                perf.stop();
+
+                                samples.push_back(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+                                sorted = sorted && std::ranges::is_sorted(elems->items());
+                            }
+                            else
+                            {
+                                auto [ns, ok] = with_store(type, [&]<typename Store>() { return time_native<Store>(name, input, perf, opts->phases); });
+                                samples.push_back(ns);
+                                sorted = sorted && ok;
+                            }
+
+                            counts.push_back(perf.totals());
+
+                            for (auto p { 0uL }; auto run : perf.phases())
+                                phases[p++].push_back(run);
+
+                            if (samples.back() > opts->budget * 1e9)
+                                break;
+                        }
+
+                        std::ranges::sort(samples);
+                        const auto& [cmps, reads, writes, swaps] = elems->counters();
+                        auto aux { scratch.stats() };
+                        auto phase_counts = std::array<sv::PerfCounts, sv::perf_phases.size()>{};
+
+                        for (auto p { 0uL }; p < phase_counts.size(); ++p)
+                            phase_counts[p] = median_counts(phases[p]);
+
+                        auto result = Result{
+                            name,
+                            mode,
+                            type,
+                            std::string{ sv::shape_name(shape) },
+                            N,
+                            samples.size(),
+                            median(samples),
+                            percentile(samples, 0.95),
+                            median(samples) / static_cast<double>(std::max(N, 1uL)),
+                            cmps,
+                            reads,
+                            writes,
+                            swaps,
+                            aux.peak,
+                            aux.allocations,
+                            median_counts(counts),
+                            phase_counts,
+                            sorted
+                        };
+
+                        std::clog << name << " (" << mode << ") / " << type << " / " << result.shape << " / " << N << ": "
+                                  << result.median_ns / 1e6 << " ms median" << (sorted ? "" : " (NOT SORTED)") << std::endl;
+
+                        history.emplace_back(N, result.median_ns / 1e9);
+                        results.push_back(result);
+                    }
+                }
+            }
+        }
+    }
+
+    auto file = std::ofstream{};
+
+    if (!opts->output.empty())
+    {
+        file.open(opts->output);
+
+        if (!file)
+        {
+            std::clog << "Could not open `" << opts->output << "` for writing." << std::endl;
+            return 1;
+        }
+    }
+
+    auto& os = opts->output.empty() ? std::cout : static_cast<std::ostream&>(file);
+
+    if (opts->format == "json"s)
+        write_json(os, results, opts->phases);
+    else
+        write_csv(os, results);
+
+    return 0;
+}
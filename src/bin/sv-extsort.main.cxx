@@ -0,0 +1,258 @@
+#include <sv/access.hxx>
+#include <sv/external.hxx>
+#include <sv/mapped_file.hxx>
+#include <sv/registry.hxx>
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+
+namespace fs = std::filesystem;
+using namespace std::literals;
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    struct Options
+    {
+        fs::path                        input       { };
+        fs::path                        output      { };
+        std::string                     type        { "f32"s };
+        std::string                     algorithm   { "Radix Sort"s };
+        std::size_t                     budget      { 256uL << 20uL };
+        std::size_t                     generate    { 0uL };
+        std::uint64_t                   seed        { 42uL };
+        bool                            verify      { false };
+    };
+
+    auto usage() -> void
+    {
+        std::clog << "Usage: sv-extsort --input FILE --output FILE [options]\n"
+                  << "  --type T               Key type of the file: f32, f64, u32 or u64 (default: f32)\n"
+                  << "  --budget SIZE          Memory to sort with, eg. 512M or 2G (default: 256M)\n"
+                  << "  --algorithm A          In-memory algorithm for the runs (default: Radix Sort)\n"
+                  << "  --generate SIZE        First fill the input with SIZE bytes of random keys\n"
+                  << "  --seed S               Seed for --generate (default: 42)\n"
+                  << "  --verify               Check the output is sorted afterwards\n";
+    }
+
+    /// Bytes, with an optional K, M or G suffix.
+    auto parse_size(std::string_view value)
+        -> std::size_t
+    {
+        auto shift { 0uL };
+
+        switch (value.empty() ? '\0' : value.back())
+        {
+            case 'K': case 'k':     shift = 10uL; break;
+            case 'M': case 'm':     shift = 20uL; break;
+            case 'G': case 'g':     shift = 30uL; break;
+            default:                break;
+        }
+
+        if (shift != 0uL)
+            value.remove_suffix(1uL);
+
+        return std::stoul(std::string{ value }) << shift;
+    }
+
+    auto parse_options(int argc, char* argv[])
+        -> std::optional<Options>
+    {
+        auto opts = Options{};
+
+        for (auto i { 1 }; i < argc; ++i)
+        {
+            auto arg = std::string_view{ argv[i] };
+
+            if (arg == "--verify"sv)
+            {
+                opts.verify = true;
+                continue;
+            }
+
+            if (arg == "--help"sv || arg == "-h"sv || i + 1 == argc)
+                return std::nullopt;
+
+            auto value = std::string_view{ argv[++i] };
+
+            try
+            {
+                if (arg == "--input"sv)
+                    opts.input = value;
+                else if (arg == "--output"sv)
+                    opts.output = value;
+                else if (arg == "--type"sv && (value == "f32"sv || value == "f64"sv || value == "u32"sv || value == "u64"sv))
+                    opts.type = value;
+                else if (arg == "--algorithm"sv)
+                    opts.algorithm = value;
+                else if (arg == "--budget"sv)
+                    opts.budget = parse_size(value);
+                else if (arg == "--generate"sv)
+                    opts.generate = parse_size(value);
+                else if (arg == "--seed"sv)
+                    opts.seed = std::stoull(std::string(value));
+                else
+                    return std::nullopt;
+            }
+            catch (const std::exception&)
+            {
+                std::clog << "Invalid value `" << value << "` for " << arg << "." << std::endl;
+                return std::nullopt;
+            }
+        }
+
+        if (opts.input.empty() || opts.output.empty())
+            return std::nullopt;
+
+        return opts;
+    }
+
+    /// Fills `path` with `bytes` of uniformly random keys, a chunk at a
+    /// time so the pages written can be dropped behind.
+    template<typename T>
+    auto generate(const fs::path& path, std::size_t bytes, std::uint64_t seed)
+        -> void
+    {
+        constexpr auto chunk { std::size_t{ 1uL << 20uL } };
+
+        auto file = sv::MappedFile::create(path, bytes / sizeof(T) * sizeof(T));
+        auto eng  = std::mt19937_64{ seed };
+        auto N    { file.size() / sizeof(T) };
+        auto keys = std::vector<T>(std::min(chunk, N));
+
+        for (auto first { 0uL }; first < N; first += chunk)
+        {
+            auto n { std::min(chunk, N - first) };
+
+            for (auto i { 0uL }; i < n; ++i)
+                if constexpr (std::floating_point<T>)
+                    keys[i] = std::uniform_real_distribution<T>{}(eng);
+                else
+                    keys[i] = static_cast<T>(eng());
+
+            std::memcpy(file.data() + first * sizeof(T), keys.data(), n * sizeof(T));
+            file.flush(first * sizeof(T), n * sizeof(T));
+            file.advise(first * sizeof(T), n * sizeof(T), MADV_DONTNEED);
+        }
+    }
+
+    /// Streams through `path` checking every key is no smaller than the
+    /// one before it.
+    template<typename T>
+    auto verify(const fs::path& path)
+        -> bool
+    {
+        constexpr auto chunk { std::size_t{ 1uL << 20uL } };
+
+        auto file = sv::MappedFile{ path };
+        auto keys = reinterpret_cast<const T*>(file.data());
+        auto N    { file.size() / sizeof(T) };
+
+        file.advise(0uL, file.size(), MADV_SEQUENTIAL);
+
+        for (auto first { 0uL }; first < N; first += chunk)
+        {
+            auto last { std::min(first + chunk, N) };
+
+            if (!std::is_sorted(keys + (first == 0uL ? 0uL : first - 1uL), keys + last))
+                return false;
+
+            file.advise(first * sizeof(T), (last - first) * sizeof(T), MADV_DONTNEED);
+        }
+
+        return true;
+    }
+
+    auto seconds(std::chrono::nanoseconds ns) noexcept
+        -> double
+    { return static_cast<double>(ns.count()) / 1e9; }
+
+    template<typename T>
+    auto run(const Options& opts)
+        -> int
+    {
+        auto native { sv::native_algorithms<sv::NativeAccess<T>>() };
+
+        if (native.find(opts.algorithm) == native.cend())
+        {
+            std::clog << "Could not find algorithm `" << opts.algorithm << "`." << std::endl;
+            return 1;
+        }
+
+        if (opts.generate != 0uL)
+        {
+            std::clog << "Generating " << opts.generate << " bytes of random " << opts.type << " keys in `" << opts.input.string() << "`." << std::endl;
+            generate<T>(opts.input, opts.generate, opts.seed);
+        }
+
+        auto sorter = sv::ExternalSort<T>{ opts.budget, native.at(opts.algorithm) };
+        auto start  { clock_type::now() };
+        auto stats  { sorter.sort(opts.input, opts.output) };
+        auto total  { clock_type::now() - start };
+        auto bytes  { static_cast<double>(stats.keys * sizeof(T)) };
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << "Keys:              " << stats.keys << " " << opts.type << "\n"
+                  << "Runs:              " << stats.runs << " of " << stats.run_length << " keys (" << opts.algorithm << ")\n"
+                  << "Merge passes:      " << stats.passes << " of up to " << stats.fan_in << " runs each\n"
+                  << "Memory:            " << static_cast<double>(stats.memory) / (1uL << 20uL) << " MiB\n"
+                  << "Bytes read:        " << stats.bytes_read << "\n"
+                  << "Bytes written:     " << stats.bytes_written << "\n"
+                  << "Run formation:     " << seconds(stats.formation.io + stats.formation.cpu) << " s "
+                  << "(I/O " << seconds(stats.formation.io) << " s, CPU " << seconds(stats.formation.cpu) << " s)\n"
+                  << "Merge:             " << seconds(stats.merge.io + stats.merge.cpu) << " s "
+                  << "(I/O " << seconds(stats.merge.io) << " s, CPU " << seconds(stats.merge.cpu) << " s)\n"
+                  << "Total:             " << seconds(total) << " s, "
+                  << bytes / (1uL << 20uL) / std::max(seconds(total), 1e-9) << " MiB/s\n";
+
+        if (opts.verify)
+        {
+            auto sorted { verify<T>(opts.output) };
+            std::cout << "Sorted:            " << (sorted ? "yes" : "NO") << "\n";
+            return sorted ? 0 : 1;
+        }
+
+        return 0;
+    }
+}
+
+auto main(int argc, char* argv[]) -> int
+{
+    auto opts { parse_options(argc, argv) };
+
+    if (!opts)
+    {
+        usage();
+        return 1;
+    }
+
+    try
+    {
+        if (opts->type == "f64"s)
+            return run<double>(*opts);
+        if (opts->type == "u32"s)
+            return run<std::uint32_t>(*opts);
+        if (opts->type == "u64"s)
+            return run<std::uint64_t>(*opts);
+
+        return run<float>(*opts);
+    }
+    catch (const std::exception& e)
+    {
+        std::clog << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,21 +1,11 @@
 #include <SFML/Graphics.hpp>
 
-#include <algorithms/bubblesort.hxx>
-#include <algorithms/bubblesortII.hxx>
-#include <algorithms/bucketsort.hxx>
-#include <algorithms/countingsort.hxx>
-#include <algorithms/heapsort.hxx>
-#include <algorithms/insertionsort.hxx>
-#include <algorithms/introsort.hxx>
-#include <algorithms/mergesort.hxx>
-#include <algorithms/pancakesort.hxx>
-#include <algorithms/quicksort.hxx>
-#include <algorithms/radixsort.hxx>
-#include <algorithms/selectionsort.hxx>
-#include <algorithms/shellsort.hxx>
-#include <algorithms/timsort.hxx>
-
 #include <sv/elements.hxx>
+#include <sv/inputs.hxx>
+#include <sv/pacer.hxx>
+#include <sv/race.hxx>
+#include <sv/race_board.hxx>
+#include <sv/registry.hxx>
 #include <sv/sorter.hxx>
 #include <sv/statusbar.hxx>
 #include <sv/sound.hxx>
@@ -23,178 +13,219 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <ranges>
 #include <source_location>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace fs = std::filesystem;
 using namespace std::literals;
 
-auto main() -> int
+namespace
 {
+    auto usage() -> void
+    {
+        std::clog << "Usage: sv [options]\n"
+                  << "  --race A,B,...         Race the named algorithms side by side\n"
+                  << "  --shape S              Input of the race: random, sorted, reversed, few-unique, sawtooth (default: random)\n"
+                  << "  --seed S               Seed for the race's input (default: 42)\n";
+    }
+
+    auto split(std::string_view str, char delim)
+        -> std::vector<std::string>
+    {
+        auto parts = std::vector<std::string>{};
+
+        for (auto part : str | std::views::split(delim))
+            if (auto s = std::string{ part.begin(), part.end() }; !s.empty())
+                parts.push_back(s);
+
+        return parts;
+    }
+
+    /// Runs `names` against each other in tiles of one window, every one
+    /// on the same input, until the window is closed.
+    auto race(
+        sf::RenderWindow& window,
+        const sv::Sorter::map_type& map,
+        const std::vector<std::string>& names,
+        sv::InputShape shape,
+        std::uint64_t seed
+    ) -> int
+    {
+        const auto [width, height] = static_cast<sf::Vector2f>(window.getSize());
+        const auto v_width { width - (width * 0.15f) };
+        const auto t_width { v_width / static_cast<float>(sv::Race::columns(names.size())) };
+        const auto num_elements { std::max(static_cast<std::size_t>(t_width * (5.0f / 48.0f)), 16uL) };
+
+        auto race = std::make_shared<sv::Race>(names, map, v_width, height, num_elements, 100.0);
+        auto board = sv::RaceBoard{ (width * 0.15f) - 10.0f, height, 14u, race };
+
+        board.setPosition(v_width + 10.0f, 0.0f);
+        race->generate(shape, seed);
+        board.input(shape, seed);
+
+        auto last_frame { std::chrono::steady_clock::now() };
+
+        while (window.isOpen())
+        {
+            auto now { std::chrono::steady_clock::now() };
+            race->frame(now - last_frame);
+            last_frame = now;
+
+            race->render();
+            board.render();
+
+            window.clear(sf::Color::Black);
+
+            for (const auto& racer : race->racers())
+                window.draw(*racer->viewer);
+
+            board.draw_captions(window);
+            window.draw(board);
+            window.display();
+
+            auto event = sf::Event{};
+            while (window.pollEvent(event))
+            {
+                if (event.type == sf::Event::KeyPressed)
+                    switch (event.key.code)
+                    {
+                        case sf::Keyboard::Escape:
+                            race->stop();
+                            window.close();
+                            break;
+
+                        case sf::Keyboard::Enter:
+                            race->start();
+                            break;
+
+                        case sf::Keyboard::Space:
+                            if (!race->running())
+                            {
+                                race->generate(shape, ++seed);
+                                board.input(shape, seed);
+                            }
+                            break;
+
+                        case sf::Keyboard::X:
+                            race->stop();
+                            break;
+
+                        case sf::Keyboard::Tab:
+                            race->toggle_pause();
+                            break;
+
+                        case sf::Keyboard::Up:
+                            race->scale_rate(2.0);
+                            break;
+
+                        case sf::Keyboard::Down:
+                            race->scale_rate(0.5);
+                            break;
+
+                        case sf::Keyboard::Right:
+                            race->scale_rate(10.0);
+                            break;
+
+                        case sf::Keyboard::Left:
+                            race->scale_rate(0.1);
+                            break;
+
+                        case sf::Keyboard::F:
+                            race->toggle_frame_lock();
+                            break;
+
+                        default:
+                            break;
+                    }
+
+                if (event.type == sf::Event::Closed)
+                {
+                    race->stop();
+                    window.close();
+                }
+            }
+        }
+
+        return 0;
+    }
+}
+
+auto main(int argc, char* argv[]) -> int
+{
+    auto map = sv::default_algorithms();
+    auto racers = std::vector<std::string>{};
+    auto shape { sv::InputShape::RANDOM };
+    auto seed { std::uint64_t{ 42uL } };
+
+    for (auto i { 1 }; i < argc; i += 2)
+    {
+        auto arg = std::string_view{ argv[i] };
+
+        if (i + 1 == argc || (arg != "--race"sv && arg != "--shape"sv && arg != "--seed"sv))
+        {
+            usage();
+            return 1;
+        }
+
+        auto value = std::string_view{ argv[i + 1] };
+
+        if (arg == "--race"sv)
+            racers = split(value, ',');
+        else if (arg == "--shape"sv)
+        {
+            if (auto parsed { sv::parse_shape(value) }; parsed)
+                shape = *parsed;
+            else
+            {
+                std::clog << "Unknown input shape `" << value << "`." << std::endl;
+                return 1;
+            }
+        }
+        else
+        {
+            try { seed = std::stoull(std::string{ value }); }
+            catch (const std::exception&)
+            {
+                std::clog << "Invalid seed `" << value << "`." << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    for (const auto& name : racers)
+        if (map.find(name) == map.cend())
+        {
+            std::clog << "Could not find algorithm `" << name << "`." << std::endl;
+            return 1;
+        }
+
     sf::RenderWindow window(sf::VideoMode::getDesktopMode(), "SV - Sorter", sf::Style::Fullscreen);
     window.setFramerateLimit(120);
+
+    if (!racers.empty())
+        return race(window, map, racers, shape, seed);
+
     const auto [width, height] = static_cast<sf::Vector2f>(window.getSize());
     const auto v_width { width - (width * 0.15f) };
-    const auto max_num_elements { static_cast<std::size_t>(v_width * (5.0f / 48.0f)) };
-
-    auto map = sv::Sorter::map_type{
-        { "Bubble Sort"s, std::tuple{
-                "B"s,
-                std::vector{ 
-                    " Time Complexity: O(n^2)"s,
-                    " Read & Swap: Red"s 
-                },
-                sv::algorithms::bubblesort
-        }},
-        { "Bubble Sort II"s, std::tuple{ 
-                "Ctrl + B"s,
-                std::vector{
-                    " Time Complexity (Worst): O(n^2)"s,
-                    " Time Complexity (Best): O(n)"s,
-                    " Reading: Red"s,
-                    " Writing: Blue"s
-                },
-                sv::algorithms::bubblesortII
-        }},
-        { "Bucket Sort"s, std::tuple{ 
-                "Shift + B"s,
-                std::vector{
-                    " Time Complexity: O(n + k)"s,
-                    " Find Minimum: Yellow"s,
-                    " Find Maximum: Cyan"s,
-                    " Reading: Red"s,
-                    " Writing: Blue"s
-                },
-                sv::algorithms::bucketsort
-        }},
-        { "Counting Sort"s, std::tuple{ 
-                "Shift + C"s,
-                std::vector{
-                    " Time Complexity: O(n^2)"s,
-                    " Find Minimum: Yellow"s,
-                    " Find Maximum: Cyan"s,
-                    " Reading: Red"s,
-                    " Writing: Blue"s
-                },
-                sv::algorithms::countingsort
-        }},
-        { "Heapsort"s, std::tuple{ 
-                "H"s,
-                std::vector{
-                    " Time Complexity: O(nlog(n))"s,
-                    " Heap Levels: Random Colors"s,
-                    " Swapping: Magenta"s
-                },
-                sv::algorithms::heapsort
-        }},
-        { "Insertion Sort"s, std::tuple{ 
-                "I"s,
-                std::vector{
-                    " Time Complexity: O(n^2)"s,
-                    " Reading: Red"s,
-                    " Writing: Blue"s
-                },
-                sv::algorithms::insertionsort
-        }},
-        { "Introsort"s, std::tuple{ 
-                "Shift + I"s,
-                std::vector{
-                    " Time Complexity: O(nlog(n))"s,
-                    " Quick Reading: Red"s,
-                    " Quick Swapping: Blue"s,
-                    " Quick Pivot: Green"s,
-                    " Insertion Reading: Yellow"s,
-                    " Insertion Writing: Cyan"s,
-                    " Heap Levels: Random Colors"s,
-                    " Heap Swapping: Magenta"s
-                },
-                sv::algorithms::introsort
-        }},
-        { "Mergesort"s, std::tuple{ 
-                "M"s,
-                std::vector{ 
-                    " Time Complexity: O(nlog(n))"s,
-                    " Reading: Red"s,
-                    " Writing: Blue"s,
-                    " Left Bound: Cyan"s,
-                    " Right Bound: Yellow"s
-                },
-                sv::algorithms::mergesort
-        }},
-        { "Pancake Sort"s, std::tuple{ 
-                "P"s,
-                std::vector{
-                    " Time Complexity: O(n^2)"s,
-                    " Reverse Swap: Blue"s,
-                    " Finding Minimum: Yellow"s
-                },
-                sv::algorithms::pancakesort
-        }},
-        { "Quicksort"s, std::tuple{ 
-                "Q"s,
-                std::vector{
-                    " Time Complexity: O(nlog(n))"s,
-                    " Reading: Red"s,
-                    " Swapping: Blue"s,
-                    " Pivot: Green"s
-                },
-                sv::algorithms::quicksort
-        }},
-        { "Radix Sort"s, std::tuple{ 
-                "R"s,
-                std::vector{
-                    " Time Complexity: O(d*(n + b))"s,
-                    " Reading: Red"s,
-                    " Writing: Blue"s,
-                    " Find Maximum: Yellow"s
-                },
-                sv::algorithms::radixsort
-        }},
-        { "Selection Sort"s, std::tuple{ 
-                "S"s,
-                std::vector{
-                    " Time Complexity: O(n^2)"s,
-                    " Writing: Blue"s,
-                    " Finding Minimum: Yellow"s
-                },
-                sv::algorithms::selectionsort
-        }},
-        { "Shell Sort"s, std::tuple{ 
-                "Shift + S"s,
-                std::vector{
-                    " Time Complexity: O(n^2)"s,
-                    " Reading: Red"s,
-                    " Writing: Blue"s
-                },
-                sv::algorithms::shellsort
-        }},
-        { "Timsort"s, std::tuple{ 
-                "T"s,
-                std::vector{
-                    " Time Complexity: O(nlog(n))"s,
-                    " Reading: Red"s,
-                    " Writing: Blue"s,
-                    " Left Bound: Cyan"s,
-                    " Right Bound: Yellow"s,
-                    " Subarray Insertion Start: Magenta"s
-                },
-                sv::algorithms::timsort
-        }}
-    };
+    const auto num_elements { static_cast<std::size_t>(v_width * (5.0f / 48.0f)) };
 
     auto sfx = std::make_shared<sv::Sound>();
+    auto pacer = std::make_shared<sv::Pacer>(100.0);
 
     auto elems = std::make_shared<sv::Elements>(
         height - (0.005f * height),
-        max_num_elements,
-        10ms,
-        10ms,
+        num_elements,
+        pacer,
         sfx
     );
 
@@ -224,8 +255,15 @@ auto main() -> int
     viewer->setPosition(0.0f, 0.0f);
     statusbar.setPosition(v_width + 10.0f, 0.0f);
 
+    auto last_frame { std::chrono::steady_clock::now() };
+
     while (window.isOpen())
     {
+        auto now { std::chrono::steady_clock::now() };
+        pacer->frame(now - last_frame);
+        sorter->update_replay(now - last_frame);
+        last_frame = now;
+
         viewer->render();
         statusbar.render();
 
@@ -245,6 +283,14 @@ auto main() -> int
                         window.close();
                         break;
                     
+                    case sf::Keyboard::X:
+                        sorter->stop();
+                        break;
+
+                    case sf::Keyboard::N:
+                        sorter->advance(event.key.control ? 10000uL : event.key.shift ? 100uL : 1uL);
+                        break;
+
                     case sf::Keyboard::Enter:
                         if (auto name { sorter->algorithm_name() }; (name != "Check"s) && (name != "Shuffle"s))
                             sorter->start();
@@ -270,38 +316,48 @@ auto main() -> int
                         break;
 
                     case sf::Keyboard::Up:
-                        sorter->adjust_delay(100us, 0us);
+                        sorter->adjust_speed(2.0);
                         break;
 
                     case sf::Keyboard::Down:
-                        sorter->adjust_delay(-100us, 0us);
+                        sorter->adjust_speed(0.5);
                         break;
 
                     case sf::Keyboard::Right:
-                        sorter->adjust_delay(0us, 100us);
+                        sorter->adjust_speed(10.0);
                         break;
 
                     case sf::Keyboard::Left:
-                        sorter->adjust_delay(0us, -100us);
+                        sorter->adjust_speed(0.1);
+                        break;
+
+                    case sf::Keyboard::F:
+                        sorter->toggle_frame_lock();
+                        break;
+
+                    case sf::Keyboard::V:
+                        sorter->toggle_mute();
                         break;
 
                     case sf::Keyboard::LBracket:
                         if (auto csize { elems->size() }; csize != 0uL) [[likely]]
-                            sorter->resize(csize - 1uL);
+                            sorter->resize(event.key.shift ? csize / 2uL : csize - 1uL);
                         else
                             std::clog << "The number of elements cannot be lower than 0!" << std::endl;
                         break;
 
                     case sf::Keyboard::RBracket:
-                        if (auto csize { elems->size() }; csize != max_num_elements) [[likely]]
-                            sorter->resize(csize + 1uL);
+                        if (auto csize { elems->size() }; event.key.shift)
+                            sorter->resize(std::max(csize * 2uL, 1uL));
                         else
-                            std::clog << "The number of elements cannot be higher than "<< max_num_elements << "!" << std::endl;
+                            sorter->resize(csize + 1uL);
                         break;
 
                     case sf::Keyboard::B:
                         if (event.key.shift)
                             sorter->select_algorithm("Bucket Sort"s);
+                        else if (event.key.control)
+                            sorter->select_algorithm("Vectorized Bucket Sort"s);
                         else if (event.key.alt)
                             sorter->select_algorithm("Bubble Sort II"s);
                         else
@@ -315,12 +371,21 @@ auto main() -> int
                     case sf::Keyboard::I:
                         if (event.key.shift)
                             sorter->select_algorithm("Introsort"s);
+                        else if (event.key.alt)
+                            sorter->select_algorithm("Parallel Introsort"s);
+                        else if (event.key.control)
+                            sorter->select_algorithm("Vectorized Introsort"s);
                         else
                             sorter->select_algorithm("Insertion Sort"s);
                         break;
 
                     case sf::Keyboard::M:
-                        sorter->select_algorithm("Mergesort"s);
+                        if (event.key.shift)
+                            sorter->select_algorithm("Parallel Mergesort"s);
+                        else if (event.key.alt)
+                            sorter->select_algorithm("External Mergesort"s);
+                        else
+                            sorter->select_algorithm("Mergesort"s);
                         break;
 
                     case sf::Keyboard::P:
@@ -328,7 +393,10 @@ auto main() -> int
                         break;
 
                     case sf::Keyboard::Q:
-                        sorter->select_algorithm("Quicksort"s);
+                        if (event.key.shift)
+                            sorter->select_algorithm("Parallel Quicksort"s);
+                        else
+                            sorter->select_algorithm("Quicksort"s);
                         break;
                     
                     case sf::Keyboard::R:
@@ -343,7 +411,63 @@ auto main() -> int
                         break;
 
                     case sf::Keyboard::T:
-                        sorter->select_algorithm("Timsort"s);
+                        if (event.key.control)
+                            sorter->select_algorithm("Vectorized Timsort"s);
+                        else
+                            sorter->select_algorithm("Timsort"s);
+                        break;
+
+                    case sf::Keyboard::F5:
+                        sorter->toggle_recording();
+                        break;
+
+                    case sf::Keyboard::F6:
+                        if (sorter->replay())
+                            sorter->stop_replay();
+                        else
+                            sorter->replay_last();
+                        break;
+
+                    case sf::Keyboard::Tab:
+                        if (auto replay { sorter->replay() }; replay)
+                            replay->toggle_pause();
+                        else
+                            sorter->toggle_pause();
+                        break;
+
+                    case sf::Keyboard::Period:
+                        if (auto replay { sorter->replay() }; replay)
+                            replay->step(event.key.shift ? 1000LL : 1LL);
+                        break;
+
+                    case sf::Keyboard::Comma:
+                        if (auto replay { sorter->replay() }; replay)
+                            replay->step(event.key.shift ? -1000LL : -1LL);
+                        break;
+
+                    case sf::Keyboard::Home:
+                        if (auto replay { sorter->replay() }; replay)
+                            replay->seek(0uL);
+                        break;
+
+                    case sf::Keyboard::End:
+                        if (auto replay { sorter->replay() }; replay)
+                            replay->seek(replay->events());
+                        break;
+
+                    case sf::Keyboard::Equal:
+                        if (auto replay { sorter->replay() }; replay)
+                            replay->scale_rate(2.0);
+                        break;
+
+                    case sf::Keyboard::Hyphen:
+                        if (auto replay { sorter->replay() }; replay)
+                            replay->scale_rate(0.5);
+                        break;
+
+                    case sf::Keyboard::Backspace:
+                        if (auto replay { sorter->replay() }; replay)
+                            replay->reverse();
                         break;
                     
                     default: